@@ -63,6 +63,16 @@ protected:
 	 */
 	virtual AbstractFSNode *getChild(const Common::String &name) const = 0;
 
+	/**
+	 * Same as getChild, for a child which is known to exist and to be a
+	 * directory or not, e.g. from an earlier listing of this directory.
+	 * Implementations can use this to avoid querying the filesystem.
+	 *
+	 * @param name String containing the name of the child to create a new node.
+	 * @param isDirectoryFlag Whether the child is a directory.
+	 */
+	virtual AbstractFSNode *getKnownChild(const Common::String &name, bool isDirectoryFlag) const { return getChild(name); }
+
 	/**
 	 * The parent node of this directory.
 	 * The parent of the root is the root itself.
@@ -173,6 +183,21 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the time the object referred by this path was last modified,
+	 * in seconds. For directories, this changes whenever entries are added,
+	 * removed or renamed.
+	 *
+	 * @return bool true if the time is known, false otherwise.
+	 */
+	virtual bool getModificationTime(uint32 &time) const { return false; }
+
+	/**
+	 * Returns the size of the file referred by this path, in bytes.
+	 *
+	 * @return bool true if the size is known, false otherwise.
+	 */
+	virtual bool getFileSize(uint32 &size) const { return false; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
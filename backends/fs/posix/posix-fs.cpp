@@ -122,6 +122,44 @@ AbstractFSNode *POSIXFilesystemNode::getChild(const Common::String &n) const {
 	return makeNode(newPath);
 }
 
+AbstractFSNode *POSIXFilesystemNode::getKnownChild(const Common::String &n, bool isDirectoryFlag) const {
+	assert(!_path.empty());
+	assert(_isDirectory);
+
+	// Make sure the string contains no slashes
+	assert(!n.contains('/'));
+
+	// Like getChildren, start with a clone of this node so that no stat()
+	// call is needed
+	POSIXFilesystemNode *entry = new POSIXFilesystemNode(*this);
+	entry->_displayName = n;
+	if (_path.lastChar() != '/')
+		entry->_path += '/';
+	entry->_path += n;
+	entry->_isDirectory = isDirectoryFlag;
+	entry->_isValid = true;
+
+	return entry;
+}
+
+bool POSIXFilesystemNode::getModificationTime(uint32 &time) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	time = (uint32)st.st_mtime;
+	return true;
+}
+
+bool POSIXFilesystemNode::getFileSize(uint32 &size) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = (uint32)st.st_size;
+	return true;
+}
+
 bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
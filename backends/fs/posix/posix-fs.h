@@ -66,8 +66,11 @@ public:
 	virtual bool isDirectory() const { return _isDirectory; }
 	virtual bool isReadable() const { return access(_path.c_str(), R_OK) == 0; }
 	virtual bool isWritable() const { return access(_path.c_str(), W_OK) == 0; }
+	virtual bool getModificationTime(uint32 &time) const;
+	virtual bool getFileSize(uint32 &size) const;
 
 	virtual AbstractFSNode *getChild(const Common::String &n) const;
+	virtual AbstractFSNode *getKnownChild(const Common::String &n, bool isDirectoryFlag) const;
 	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const;
 	virtual AbstractFSNode *getParent() const;
 
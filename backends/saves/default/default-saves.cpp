@@ -51,10 +51,10 @@
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+DefaultSaveFileManager::DefaultSaveFileManager() : _cachedDirectoryTime(0), _hasCachedDirectoryTime(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _cachedDirectoryTime(0), _hasCachedDirectoryTime(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
@@ -82,15 +82,29 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 	if (getError().getCode() != Common::kNoError)
 		return Common::StringArray();
 
+	PatternCache::iterator matches = _patternCache.find(pattern);
+	if (matches == _patternCache.end()) {
+		Common::StringArray &results = _patternCache[pattern];
+		for (SaveFileCache::const_iterator file = _saveFileCache.begin(), end = _saveFileCache.end(); file != end; ++file) {
+			if (file->_key.matchString(pattern, true)) {
+				results.push_back(file->_key);
+			}
+		}
+		matches = _patternCache.find(pattern);
+	}
+
+	if (_lockedFiles.empty())
+		return matches->_value;
+
 	Common::HashMap<Common::String, bool> locked;
 	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
 		locked[*i] = true;
 	}
 
 	Common::StringArray results;
-	for (SaveFileCache::const_iterator file = _saveFileCache.begin(), end = _saveFileCache.end(); file != end; ++file) {
-		if (!locked.contains(file->_key) && file->_key.matchString(pattern, true)) {
-			results.push_back(file->_key);
+	for (Common::StringArray::const_iterator i = matches->_value.begin(), end = matches->_value.end(); i != end; ++i) {
+		if (!locked.contains(*i)) {
+			results.push_back(*i);
 		}
 	}
 	return results;
@@ -156,10 +170,11 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	const bool isNewFile = (file == _saveFileCache.end());
 	Common::FSNode fileNode;
 
 	// If the file did not exist before, we add it to the cache.
-	if (file == _saveFileCache.end()) {
+	if (isNewFile) {
 		const Common::FSNode savePath(savePathName);
 		fileNode = savePath.getChild(filename);
 	} else {
@@ -172,6 +187,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	if (isNewFile)
+		saveFileCacheChanged();
 
 	return result;
 }
@@ -213,13 +230,79 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 			if (errno == ENOENT)
 				setError(Common::kPathDoesNotExist, "removeSavefile: '"+fileNode.getName()+"' does not exist or path is invalid");
 #endif
+			saveFileCacheChanged();
 			return false;
 		} else {
+			saveFileCacheChanged();
 			return true;
 		}
 	}
 }
 
+bool DefaultSaveFileManager::renameSavefile(const Common::String &oldFilename, const Common::String &newFilename) {
+	// Assure the savefile name cache is up-to-date.
+	const Common::String savePathName = getSavePath();
+	assureCached(savePathName);
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
+		if (newFilename == *i) {
+			return false; //file is locked, no saving available
+		}
+	}
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(oldFilename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	const Common::String oldPath = file->_value.getPath();
+	const Common::String newPath = Common::FSNode(savePathName).getChild(newFilename).getPath();
+
+	// rename() replaces an existing file atomically on POSIX systems. Others,
+	// like Windows, refuse to replace it, in which case it is removed first.
+	// If rename() is not available at all, the savefile is copied.
+	if (rename(oldPath.c_str(), newPath.c_str()) != 0) {
+		if (!Common::FSNode(newPath).exists() || remove(newPath.c_str()) != 0 || rename(oldPath.c_str(), newPath.c_str()) != 0) {
+			// Rebuild the cache, as it is not known which files still exist
+			_cachedDirectory.clear();
+
+			// Copy the raw file, so that it is not unpacked and recompressed
+			bool copied = false;
+			Common::InSaveFile *inFile = openRawFile(oldFilename);
+			Common::OutSaveFile *outFile = inFile ? openForSaving(newFilename, false) : 0;
+			if (outFile) {
+				byte buffer[4096];
+				while (!inFile->eos() && !inFile->err() && !outFile->err())
+					outFile->write(buffer, inFile->read(buffer, sizeof(buffer)));
+				outFile->finalize();
+				copied = !inFile->err() && !outFile->err();
+				delete outFile;
+			}
+			delete inFile;
+
+			return copied && removeSavefile(oldFilename);
+		}
+	}
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// Update the files' timestamps
+	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
+	timestamps.erase(oldFilename);
+	timestamps[newFilename] = INVALID_TIMESTAMP;
+	saveTimestamps(timestamps);
+#endif
+
+	_saveFileCache.erase(oldFilename);
+	_saveFileCache[newFilename] = Common::FSNode(newPath);
+	saveFileCacheChanged();
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	CloudMan.syncSaves();
+#endif
+	return true;
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -245,7 +328,8 @@ Common::String DefaultSaveFileManager::getSavePath() const {
 
 void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	// Check that path exists and is usable.
-	checkPath(Common::FSNode(savePathName));
+	const Common::FSNode savePathNode(savePathName);
+	checkPath(savePathNode);
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	Common::Array<Common::String> files = CloudMan.getSyncingFiles(); //returns empty array if not syncing
@@ -254,10 +338,18 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 #endif
 
 	if (_cachedDirectory == savePathName) {
-		return;
+		// Savefiles added or removed by someone else change the modification
+		// time of the directory. Note that this misses changes made within
+		// the same second as the last one we know of, on file systems which
+		// only store the time in seconds.
+		uint32 time;
+		if (!_hasCachedDirectoryTime || !savePathNode.getModificationTime(time) || time == _cachedDirectoryTime) {
+			return;
+		}
 	}
 
 	_saveFileCache.clear();
+	_patternCache.clear();
 	_cachedDirectory.clear();
 
 	if (getError().getCode() != Common::kNoError) {
@@ -265,6 +357,11 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 		return;
 	}
 
+	// Query the time before listing the directory, so that changes made
+	// while listing it are noticed next time.
+	uint32 directoryTime = 0;
+	const bool hasDirectoryTime = savePathNode.getModificationTime(directoryTime);
+
 	// FSNode can cache its members, thus create it after checkPath to reflect
 	// actual file system state.
 	const Common::FSNode savePath(savePathName);
@@ -286,6 +383,16 @@ void DefaultSaveFileManager::assureCached(const Common::String &savePathName) {
 	// Only now store that we cached 'savePathName' to indicate we successfully
 	// cached the directory.
 	_cachedDirectory = savePathName;
+	_cachedDirectoryTime = directoryTime;
+	_hasCachedDirectoryTime = hasDirectoryTime;
+}
+
+void DefaultSaveFileManager::saveFileCacheChanged() {
+	_patternCache.clear();
+
+	// Our own change should not make assureCached() rebuild the cache
+	if (_hasCachedDirectoryTime)
+		_hasCachedDirectoryTime = Common::FSNode(_cachedDirectory).getModificationTime(_cachedDirectoryTime);
 }
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
@@ -44,6 +44,8 @@ public:
 	virtual Common::InSaveFile *openForLoading(const Common::String &filename);
 	virtual Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true);
 	virtual bool removeSavefile(const Common::String &filename);
+	virtual bool renameSavefile(const Common::String &oldFilename, const Common::String &newFilename);
+	virtual bool canRenameSavefiles() const { return true; }
 
 #ifdef USE_LIBCURL
 
@@ -71,12 +73,21 @@ protected:
 	virtual void checkPath(const Common::FSNode &dir);
 
 	/**
-	 * Assure that the given save path is cached.
+	 * Assure that the given save path is cached. The cache is rebuilt when
+	 * the save path changed, or when the modification time of the save
+	 * directory shows that savefiles were added or removed by someone else.
 	 *
 	 * @param savePathName  String representation of save path to cache.
 	 */
 	void assureCached(const Common::String &savePathName);
 
+	/**
+	 * Must be called after changing _saveFileCache. Drops the listings
+	 * computed from it, and takes note of the save directory's new
+	 * modification time, as the change was our own.
+	 */
+	void saveFileCacheChanged();
+
 	typedef Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileCache;
 
 	/**
@@ -99,6 +110,21 @@ private:
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/**
+	 * The modification time of the cached directory when it was cached, if
+	 * _hasCachedDirectoryTime is set.
+	 */
+	uint32 _cachedDirectoryTime;
+	bool _hasCachedDirectoryTime;
+
+	typedef Common::HashMap<Common::String, Common::StringArray> PatternCache;
+
+	/**
+	 * The savefiles matching each pattern passed to listSavefiles, without
+	 * taking the locked files into account.
+	 */
+	PatternCache _patternCache;
 };
 
 #endif
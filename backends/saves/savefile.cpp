@@ -29,7 +29,9 @@
 
 namespace Common {
 
-OutSaveFile::OutSaveFile(WriteStream *w): _wrapped(w) {}
+OutSaveFile::OutSaveFile(WriteStream *w): _wrapped(w), _container(0) {}
+
+OutSaveFile::OutSaveFile(SaveContainerWriteStream *w): _wrapped(w), _container(w) {}
 
 OutSaveFile::~OutSaveFile() {}
 
@@ -54,6 +56,19 @@ int32 OutSaveFile::pos() const {
 	return _wrapped->pos();
 }
 
+void OutSaveFile::endMetadata() {
+	if (_container)
+		_container->endMetadata();
+}
+
+OutSaveFile *SaveFileManager::openContainerForSaving(const String &name, int level, bool dedup) {
+	OutSaveFile *file = openForSaving(name, false);
+	if (!file)
+		return 0;
+
+	return new OutSaveFile(new SaveContainerWriteStream(file, level, dedup));
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename) {
 	InSaveFile *inFile = 0;
 	OutSaveFile *outFile = 0;
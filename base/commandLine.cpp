@@ -262,6 +262,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_sdl_parachute", false);
 
 	ConfMan.registerDefault("disable_display", false);
+	ConfMan.registerDefault("fs_index", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
 
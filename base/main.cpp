@@ -31,6 +31,7 @@
 // FIXME: Avoid using printf
 #define FORBIDDEN_SYMBOL_EXCEPTION_printf
 
+#include "engines/advancedDetector.h"
 #include "engines/engine.h"
 #include "engines/metaengine.h"
 #include "base/commandLine.h"
@@ -429,6 +430,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	if (Base::processSettings(command, settings, res)) {
 		if (res.getCode() != Common::kNoError)
 			warning("%s", res.getDesc().c_str());
+		// Keep what --detect and friends found for the next run
+		ADFilePropertiesCache::destroy();
 		return res.getCode();
 	}
 
@@ -614,6 +617,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	Cloud::CloudManager::destroy();
 #endif
 #endif
+	ADFilePropertiesCache::destroy();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
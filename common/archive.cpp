@@ -265,6 +265,33 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) con
 	return 0;
 }
 
+bool SearchSet::hasFileAtom(const Atom &name) const {
+	if (name.empty())
+		return false;
+
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		if (it->_arc->hasFile(name))
+			return true;
+	}
+
+	return false;
+}
+
+SeekableReadStream *SearchSet::createReadStreamForMemberAtom(const Atom &name) const {
+	if (name.empty())
+		return 0;
+
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
+		if (stream)
+			return stream;
+	}
+
+	return 0;
+}
+
 
 SearchManager::SearchManager() {
 	clear();    // Force a reset
@@ -23,6 +23,7 @@
 #ifndef COMMON_ARCHIVE_H
 #define COMMON_ARCHIVE_H
 
+#include "common/atom.h"
 #include "common/str.h"
 #include "common/list.h"
 #include "common/ptr.h"
@@ -123,6 +124,19 @@ public:
 	 * @return the newly created input stream
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const = 0;
+
+	/**
+	 * Same as hasFile and createReadStreamForMember, for callers which keep
+	 * the names they look up often as Atoms. Archives which can do better
+	 * than looking up the Atom's string override hasFileAtom and
+	 * createReadStreamForMemberAtom.
+	 */
+	bool hasFile(const Atom &name) const { return hasFileAtom(name); }
+	SeekableReadStream *createReadStreamForMember(const Atom &name) const { return createReadStreamForMemberAtom(name); }
+
+protected:
+	virtual bool hasFileAtom(const Atom &name) const { return hasFile(name.toString()); }
+	virtual SeekableReadStream *createReadStreamForMemberAtom(const Atom &name) const { return createReadStreamForMember(name.toString()); }
 };
 
 
@@ -247,6 +261,13 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	using Archive::hasFile;
+	using Archive::createReadStreamForMember;
+
+protected:
+	virtual bool hasFileAtom(const Atom &name) const;
+	virtual SeekableReadStream *createReadStreamForMemberAtom(const Atom &name) const;
 };
 
 
@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize)
+	: _blockSize(blockSize), _current(0), _used(0), _usedBefore(0) {
+	assert(blockSize > 0);
+}
+
+Arena::~Arena() {
+	for (uint i = 0; i < _blocks.size(); ++i)
+		::free(_blocks[i]._start);
+}
+
+void *Arena::allocate(size_t size) {
+	size = (size + kAlignment - 1) & ~(size_t)(kAlignment - 1);
+
+	if (!_blocks.empty() && size <= _blocks[_current]._size - _used) {
+		void *result = _blocks[_current]._start + _used;
+		_used += size;
+		return result;
+	}
+
+	// Move on to the next block which is large enough. Blocks which are
+	// skipped remain unused until the arena is rewound.
+	uint next = _blocks.empty() ? 0 : _current + 1;
+	while (next < _blocks.size() && _blocks[next]._size < size)
+		++next;
+
+	if (next == _blocks.size()) {
+		Block block;
+		block._size = MAX(_blockSize, size);
+		block._start = (byte *)::malloc(block._size);
+		if (!block._start)
+			::error("Common::Arena: failure to allocate %u bytes", (uint)block._size);
+		_blocks.push_back(block);
+	}
+
+	_usedBefore += _used;
+	_current = next;
+	_used = size;
+	return _blocks[_current]._start;
+}
+
+Arena::Marker Arena::getMarker() const {
+	Marker marker;
+	marker._block = _current;
+	marker._used = _used;
+	marker._usedBefore = _usedBefore;
+	return marker;
+}
+
+void Arena::rewind(const Marker &marker) {
+	assert(marker._block < _current || (marker._block == _current && marker._used <= _used));
+	_current = marker._block;
+	_used = marker._used;
+	_usedBefore = marker._usedBefore;
+}
+
+void Arena::reset() {
+	_current = 0;
+	_used = 0;
+	_usedBefore = 0;
+}
+
+void Arena::freeUnusedBlocks() {
+	// The blocks after the current one are not in use, and neither is the
+	// current one if nothing has been allocated at all
+	const uint inUse = (_current == 0 && _used == 0) ? 0 : _current + 1;
+	for (uint i = inUse; i < _blocks.size(); ++i)
+		::free(_blocks[i]._start);
+	_blocks.resize(inUse);
+}
+
+size_t Arena::getUsedSize() const {
+	return _usedBefore + _used;
+}
+
+} // End of namespace Common
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * A region based allocator: memory is handed out from large blocks by
+ * bumping a pointer, and is never freed individually. Instead, all memory
+ * allocated after a certain point is released at once by rewinding the
+ * arena, which takes constant time. The blocks are kept for reuse, so an
+ * arena used for the temporary data of every frame or room stops calling
+ * malloc() once it has grown to the size needed, and does not fragment the
+ * heap.
+ *
+ * Destructors of objects allocated from an arena are not called when it is
+ * rewound. Containers using an ArenaAllocator must therefore be destroyed
+ * before the memory they use is released; see ArenaScope.
+ */
+class Arena : NonCopyable {
+public:
+	/** A position in an arena, see getMarker() and rewind(). */
+	struct Marker {
+		uint _block;
+		size_t _used;
+		size_t _usedBefore;
+	};
+
+	/**
+	 * Constructor for an arena.
+	 * @param blockSize		the size of the blocks obtained from malloc();
+	 *						larger allocations get a block of their own
+	 */
+	explicit Arena(size_t blockSize = kDefaultBlockSize);
+	~Arena();
+
+	/**
+	 * Allocate memory from the arena. Allocations start at multiples of 16
+	 * bytes within blocks obtained from malloc(), so they are aligned at
+	 * least as well as memory returned by malloc() itself.
+	 */
+	void *allocate(size_t size);
+
+	/** Return the current position, for passing to rewind() later on. */
+	Marker getMarker() const;
+
+	/**
+	 * Release all memory allocated since the given marker was obtained.
+	 * Markers obtained after that one become invalid.
+	 */
+	void rewind(const Marker &marker);
+
+	/** Release all memory allocated from the arena. */
+	void reset();
+
+	/**
+	 * Return the blocks which are not in use to the system. Ordinarily, they
+	 * are kept for reuse during the life time of the arena.
+	 */
+	void freeUnusedBlocks();
+
+	/**
+	 * Return the amount of memory currently allocated from the arena,
+	 * including the padding for alignment.
+	 */
+	size_t getUsedSize() const;
+
+private:
+	enum {
+		kDefaultBlockSize = 65536,
+		kAlignment = 16
+	};
+
+	struct Block {
+		byte *_start;
+		size_t _size;
+	};
+
+	const size_t _blockSize;
+	Array<Block> _blocks;
+	uint _current;		///< The block allocations are made from
+	size_t _used;		///< The amount of memory used in _blocks[_current]
+	size_t _usedBefore;	///< The amount of memory used in the blocks before _current
+};
+
+/**
+ * Rewinds an arena to the point at which the scope was entered when it is
+ * left, e.g. at the end of a frame:
+ *
+ *   Common::ArenaScope scope(_frameArena);
+ *   Common::Array<Ticket *, Common::ArenaAllocator> tickets(_frameArena);
+ *   ...
+ *
+ * Objects in the scope are destroyed in reverse order, so containers
+ * declared after the ArenaScope are destroyed before the memory is released.
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena &arena) : _arena(arena), _marker(arena.getMarker()) {}
+	~ArenaScope() { _arena.rewind(_marker); }
+
+private:
+	Arena &_arena;
+	const Arena::Marker _marker;
+};
+
+/**
+ * An allocator for containers like Array and List, which obtains memory
+ * from an Arena. Freeing memory does nothing; growing an Array leaves the
+ * old storage unused until the arena is rewound.
+ */
+class ArenaAllocator {
+public:
+	ArenaAllocator(Arena &arena) : _arena(&arena) {}
+
+	void *allocate(size_t size) { return _arena->allocate(size); }
+	void deallocate(void *ptr) {}
+
+private:
+	Arena *_arena;
+};
+
+} // End of namespace Common
+
+/**
+ * A custom placement new operator, using an Arena. Objects created with it
+ * have to be destroyed by explicitly calling their destructor, if needed.
+ */
+inline void *operator new(size_t nbytes, Common::Arena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *p, Common::Arena &arena) {
+}
+
+#endif
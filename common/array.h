@@ -40,9 +40,11 @@ namespace Common {
  *
  * The container class closest to this in the C++ standard library is
  * std::vector. However, there are some differences.
+ *
+ * The storage is obtained from the given Allocator, see DefaultAllocator.
  */
-template<class T>
-class Array {
+template<class T, class Allocator = DefaultAllocator>
+class Array : private Allocator {
 public:
 	typedef T *iterator;
 	typedef const T *const_iterator;
@@ -59,6 +61,12 @@ protected:
 public:
 	Array() : _capacity(0), _size(0), _storage(0) {}
 
+	/**
+	 * Constructs an empty array which obtains its storage from the given
+	 * allocator.
+	 */
+	explicit Array(const Allocator &allocator) : Allocator(allocator), _capacity(0), _size(0), _storage(0) {}
+
 	/**
 	 * Constructs an array with `count` default-inserted instances of T. No
 	 * copies are made.
@@ -77,7 +85,7 @@ public:
 		uninitialized_fill_n(_storage, count, value);
 	}
 
-	Array(const Array<T> &array) : _capacity(array._size), _size(array._size), _storage(0) {
+	Array(const Array &array) : Allocator(array.getAllocator()), _capacity(array._size), _size(array._size), _storage(0) {
 		if (array._storage) {
 			allocCapacity(_size);
 			uninitialized_copy(array._storage, array._storage + _size, _storage);
@@ -108,7 +116,7 @@ public:
 			insert_aux(end(), &element, &element + 1);
 	}
 
-	void push_back(const Array<T> &array) {
+	void push_back(const Array &array) {
 		if (_size + array.size() <= _capacity) {
 			uninitialized_copy(array.begin(), array.end(), end());
 			_size += array.size();
@@ -164,7 +172,7 @@ public:
 		insert_aux(_storage + idx, &element, &element + 1);
 	}
 
-	void insert_at(size_type idx, const Array<T> &array) {
+	void insert_at(size_type idx, const Array &array) {
 		assert(idx <= _size);
 		insert_aux(_storage + idx, array.begin(), array.end());
 	}
@@ -198,7 +206,7 @@ public:
 		return _storage[idx];
 	}
 
-	Array<T> &operator=(const Array<T> &array) {
+	Array &operator=(const Array &array) {
 		if (this == &array)
 			return *this;
 
@@ -233,7 +241,7 @@ public:
 		return (_size == 0);
 	}
 
-	bool operator==(const Array<T> &other) const {
+	bool operator==(const Array &other) const {
 		if (this == &other)
 			return true;
 		if (_size != other._size)
@@ -245,7 +253,7 @@ public:
 		return true;
 	}
 
-	bool operator!=(const Array<T> &other) const {
+	bool operator!=(const Array &other) const {
 		return !(*this == other);
 	}
 
@@ -294,6 +302,11 @@ public:
 	}
 
 protected:
+	// The allocator is a base class rather than a member, so that empty
+	// allocators do not take up any space
+	Allocator &getAllocator() { return *this; }
+	const Allocator &getAllocator() const { return *this; }
+
 	static size_type roundUpCapacity(size_type capacity) {
 		// Round up capacity to the next power of 2;
 		// we use a minimal capacity of 8.
@@ -306,7 +319,7 @@ protected:
 	void allocCapacity(size_type capacity) {
 		_capacity = capacity;
 		if (capacity) {
-			_storage = (T *)malloc(sizeof(T) * capacity);
+			_storage = (T *)getAllocator().allocate(sizeof(T) * capacity);
 			if (!_storage)
 				::error("Common::Array: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
 		} else {
@@ -317,7 +330,8 @@ protected:
 	void freeStorage(T *storage, const size_type elements) {
 		for (size_type i = 0; i < elements; ++i)
 			storage[i].~T();
-		free(storage);
+		if (storage)
+			getAllocator().deallocate(storage);
 	}
 
 	/**
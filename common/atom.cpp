@@ -0,0 +1,89 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/atom.h"
+#include "common/hash-str.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * The table of all interned strings. Like the rest of the lookup code, it
+ * is not thread safe.
+ */
+class AtomTable : public Singleton<AtomTable> {
+	typedef HashMap<String, Atom::Entry *, IgnoreCase_Hash, IgnoreCase_EqualTo> EntryMap;
+	EntryMap _entries;
+
+public:
+	~AtomTable() {
+		for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it)
+			delete it->_value;
+	}
+
+	const Atom::Entry *find(const String &str) const {
+		return _entries.getVal(str, 0);
+	}
+
+	const Atom::Entry *intern(const String &str) {
+		Atom::Entry *&entry = _entries[str];
+		if (!entry)
+			entry = new Atom::Entry(str);
+		return entry;
+	}
+};
+
+DECLARE_SINGLETON(AtomTable);
+
+Atom::Entry::Entry(const String &str) : _string(str), _hash(hashit_lower(str)) {
+}
+
+Atom::Atom(const String &str) : _entry(0) {
+	if (!str.empty())
+		_entry = AtomTable::instance().intern(str);
+}
+
+Atom::Atom(const char *str) : _entry(0) {
+	if (*str)
+		_entry = AtomTable::instance().intern(str);
+}
+
+bool Atom::find(const String &str, Atom &atom) {
+	if (str.empty()) {
+		atom = Atom();
+		return true;
+	}
+
+	const Entry *entry = AtomTable::instance().find(str);
+	if (!entry)
+		return false;
+
+	atom = Atom(entry);
+	return true;
+}
+
+const String &Atom::toString() const {
+	static const String emptyString;
+	return _entry ? _entry->_string : emptyString;
+}
+
+} // End of namespace Common
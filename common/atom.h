@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOM_H
+#define COMMON_ATOM_H
+
+#include "common/str.h"
+
+namespace Common {
+
+class AtomTable;
+
+/**
+ * An Atom is a handle to a string stored in a global table of interned
+ * strings. Creating an Atom from a string hashes the string once; after that,
+ * comparing two Atoms is a pointer comparison and their hash is precomputed,
+ * which makes them cheap keys for lookup tables which are queried a lot.
+ *
+ * Atoms are case insensitive, like the file and configuration lookups they
+ * are meant for: all spellings of a string differing only in case map to the
+ * same Atom, whose string is the spelling it was first created with.
+ *
+ * Interned strings are never freed, so Atoms should only be created for
+ * strings from a limited set, such as file names or configuration keys.
+ * Use find() to look up strings which are not known to be in that set.
+ */
+class Atom {
+	friend class AtomTable;
+
+	struct Entry {
+		String _string;
+		uint _hash;	///< hashit_lower() of the string
+		explicit Entry(const String &str);
+	};
+
+	const Entry *_entry;	///< 0 for the empty string
+
+	explicit Atom(const Entry *entry) : _entry(entry) {}
+
+public:
+	/** Creates an Atom for the empty string. */
+	Atom() : _entry(0) {}
+
+	/** Interns the given string. */
+	explicit Atom(const String &str);
+	explicit Atom(const char *str);
+
+	/**
+	 * Looks up the Atom for the given string, without interning it.
+	 *
+	 * @param str	the string to look up
+	 * @param atom	set to the Atom for str if there is one
+	 * @return true if str has been interned before, or is empty
+	 */
+	static bool find(const String &str, Atom &atom);
+
+	const String &toString() const;
+	const char *c_str() const { return toString().c_str(); }
+
+	bool empty() const { return _entry == 0; }
+
+	/** Returns the same hash as hashit_lower() does for the string. */
+	uint hash() const { return _entry ? _entry->_hash : 0; }
+
+	bool operator==(const Atom &x) const { return _entry == x._entry; }
+	bool operator!=(const Atom &x) const { return _entry != x._entry; }
+};
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,242 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_BYTECURSOR_H
+#define COMMON_BYTECURSOR_H
+
+#include "common/endian.h"
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * A read cursor over a borrowed block of memory. It offers the same read
+ * methods as ReadStream, but none of them is virtual, so reading many small
+ * fields, e.g. when parsing resource tables, compiles down to plain loads.
+ *
+ * Cursors are obtained from a buffer, a Span (see SpanBase::toCursor()) or
+ * a memory based stream (see SeekableReadStream::getCursor()). They do not
+ * own the memory they read from.
+ *
+ * Like streams, reading beyond the end sets the eos() flag; the value of
+ * such a read is 0, and the cursor is left at the end.
+ */
+class ByteCursor {
+public:
+	ByteCursor() : _start(0), _ptr(0), _end(0), _eos(false) {}
+	ByteCursor(const byte *data, uint32 size) : _start(data), _ptr(data), _end(data + size), _eos(false) {}
+
+	/** The start of the memory read by this cursor. */
+	const byte *getData() const { return _start; }
+	/** The memory at the current position. */
+	const byte *getPtr() const { return _ptr; }
+
+	uint32 pos() const { return _ptr - _start; }
+	uint32 size() const { return _end - _start; }
+	uint32 remaining() const { return _end - _ptr; }
+
+	/** Returns true if a read failed because the end has been reached. */
+	bool eos() const { return _eos; }
+	void clearErr() { _eos = false; }
+
+	/**
+	 * Move to the given position. Like SeekableReadStream::seek(), this
+	 * clears the eos() flag.
+	 * @return false if the position is beyond the end
+	 */
+	bool seek(uint32 pos) {
+		if (pos > size())
+			return false;
+		_ptr = _start + pos;
+		_eos = false;
+		return true;
+	}
+
+	/**
+	 * Skip the given amount of bytes.
+	 * @return false if that would move beyond the end
+	 */
+	bool skip(uint32 offset) {
+		return seek(pos() + offset);
+	}
+
+	byte readByte() {
+		if (!ensure(1))
+			return 0;
+		return *_ptr++;
+	}
+
+	int8 readSByte() {
+		return (int8)readByte();
+	}
+
+	uint16 readUint16LE() {
+		if (!ensure(2))
+			return 0;
+		const uint16 val = READ_LE_UINT16(_ptr);
+		_ptr += 2;
+		return val;
+	}
+
+	uint32 readUint32LE() {
+		if (!ensure(4))
+			return 0;
+		const uint32 val = READ_LE_UINT32(_ptr);
+		_ptr += 4;
+		return val;
+	}
+
+	uint16 readUint16BE() {
+		if (!ensure(2))
+			return 0;
+		const uint16 val = READ_BE_UINT16(_ptr);
+		_ptr += 2;
+		return val;
+	}
+
+	uint32 readUint32BE() {
+		if (!ensure(4))
+			return 0;
+		const uint32 val = READ_BE_UINT32(_ptr);
+		_ptr += 4;
+		return val;
+	}
+
+	int16 readSint16LE() {
+		return (int16)readUint16LE();
+	}
+
+	int32 readSint32LE() {
+		return (int32)readUint32LE();
+	}
+
+	int16 readSint16BE() {
+		return (int16)readUint16BE();
+	}
+
+	int32 readSint32BE() {
+		return (int32)readUint32BE();
+	}
+
+	/**
+	 * Copy up to dataSize bytes into dataPtr.
+	 * @return the number of bytes which were actually read
+	 */
+	uint32 read(void *dataPtr, uint32 dataSize) {
+		if (dataSize > remaining()) {
+			dataSize = remaining();
+			_eos = true;
+		}
+		memcpy(dataPtr, _ptr, dataSize);
+		_ptr += dataSize;
+		return dataSize;
+	}
+
+	/**
+	 * Read count unsigned 16-bit words stored in little endian (LSB first)
+	 * order into dst.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint16LEArray(uint16 *dst, uint32 count) {
+		const uint32 n = readArray(dst, count, 2);
+#ifdef SCUMM_BIG_ENDIAN
+		swapBytes16(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 32-bit words stored in little endian (LSB first)
+	 * order into dst.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint32LEArray(uint32 *dst, uint32 count) {
+		const uint32 n = readArray(dst, count, 4);
+#ifdef SCUMM_BIG_ENDIAN
+		swapBytes32(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 16-bit words stored in big endian (MSB first)
+	 * order into dst.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint16BEArray(uint16 *dst, uint32 count) {
+		const uint32 n = readArray(dst, count, 2);
+#ifdef SCUMM_LITTLE_ENDIAN
+		swapBytes16(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 32-bit words stored in big endian (MSB first)
+	 * order into dst.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint32BEArray(uint32 *dst, uint32 count) {
+		const uint32 n = readArray(dst, count, 4);
+#ifdef SCUMM_LITTLE_ENDIAN
+		swapBytes32(dst, n);
+#endif
+		return n;
+	}
+
+private:
+	/** Check that n more bytes are available, otherwise set eos. */
+	bool ensure(uint32 n) {
+		if ((uint32)(_end - _ptr) >= n)
+			return true;
+		_ptr = _end;
+		_eos = true;
+		return false;
+	}
+
+	/**
+	 * Copy count elements of the given size, or as many complete ones as
+	 * available, in which case eos is set like for the other reads.
+	 */
+	uint32 readArray(void *dst, uint32 count, uint32 elementSize) {
+		const uint32 available = remaining() / elementSize;
+		if (available >= count) {
+			memcpy(dst, _ptr, count * elementSize);
+			_ptr += count * elementSize;
+			return count;
+		}
+
+		memcpy(dst, _ptr, available * elementSize);
+		_ptr = _end;
+		_eos = true;
+		return available;
+	}
+
+	const byte *_start;
+	const byte *_ptr;
+	const byte *_end;
+	bool _eos;
+};
+
+} // End of namespace Common
+
+#endif
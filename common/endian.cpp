@@ -0,0 +1,65 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/endian.h"
+
+#if defined(__SSE2__)
+#define USE_SSE2_SWAP_BYTES
+#include <emmintrin.h>
+#endif
+
+namespace Common {
+
+void swapBytes16(uint16 *data, uint32 count) {
+	uint32 i = 0;
+
+#ifdef USE_SSE2_SWAP_BYTES
+	for (; i + 8 <= count; i += 8) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#endif
+
+	for (; i < count; ++i)
+		data[i] = SWAP_BYTES_16(data[i]);
+}
+
+void swapBytes32(uint32 *data, uint32 count) {
+	uint32 i = 0;
+
+#ifdef USE_SSE2_SWAP_BYTES
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(data + i));
+		// Swap the bytes of each 16-bit half, then swap the halves
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		_mm_storeu_si128((__m128i *)(data + i), v);
+	}
+#endif
+
+	for (; i < count; ++i)
+		data[i] = SWAP_BYTES_32(data[i]);
+}
+
+} // End of namespace Common
@@ -199,6 +199,23 @@
 	}
 #endif
 
+namespace Common {
+
+/**
+ * Swap the byte order of count 16-bit values in place. Use this instead of
+ * SWAP_BYTES_16 when converting whole tables, as it converts several values
+ * at once where the CPU supports it.
+ */
+void swapBytes16(uint16 *data, uint32 count);
+
+/**
+ * Swap the byte order of count 32-bit values in place.
+ * @see swapBytes16
+ */
+void swapBytes32(uint32 *data, uint32 count);
+
+} // End of namespace Common
+
 
 
 /**
@@ -0,0 +1,546 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/func.h"
+
+namespace Common {
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in alternative to HashMap<Key,Val> which
+ * stores its entries inline in one contiguous array instead of allocating a
+ * node for each of them.
+ *
+ * Every slot has a control byte, kept in a separate dense array, which tells
+ * whether the slot is empty, erased or in use; in the latter case it also
+ * holds seven bits of the key's hash. Lookups scan the control bytes and only
+ * compare keys whose hash bits match. The full hash is stored next to each
+ * entry, so rehashing the map never calls the hash function again.
+ *
+ * Compared to HashMap, lookups and insertions of keys which are expensive to
+ * hash or compare, like strings, are considerably faster, while lookups of
+ * small integer keys are slightly slower.
+ *
+ * The public interface and the iterator semantics are the same as those of
+ * HashMap: erasing an entry leaves all other entries in place, so erasing the
+ * current entry while iterating is fine. Unlike with HashMap, adding entries
+ * moves the existing ones when the map grows, so references to values must
+ * not be kept across insertions.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		const Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+	};
+
+	struct Slot {
+		size_type _hash;
+		Node _node;
+	};
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// slots, including erased ones, may fill up before the map is
+		// rehashed.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 2,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 3
+	};
+
+	enum {
+		kCtrlEmpty = 0x80,	///< Slot has never been used since the last rehash
+		kCtrlErased = 0xFE	///< Slot held an entry which has been erased
+		// Any value below 0x80 marks a slot in use, holding the low seven
+		// bits of the key's hash
+	};
+
+	byte *_ctrl;		///< control bytes, one per slot
+	Slot *_slots;		///< raw storage; only slots in use hold a constructed node
+	size_type _mask;	///< Capacity of the map minus one; the capacity is a power of two
+	size_type _shift;	///< 32 minus the binary logarithm of the capacity
+	size_type _size;
+	size_type _erased;	///< Number of erased slots
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	static bool isUsed(byte ctrl) { return !(ctrl & 0x80); }
+	static byte ctrlForHash(size_type hash) { return hash & 0x7F; }
+
+	/** Returns the first slot to probe for the given hash. */
+	size_type homeSlot(size_type hash) const {
+		// Fibonacci hashing spreads hashes differing only in their upper
+		// bits, such as those of small integer keys, over the whole table.
+		return (size_type)((uint32)(hash * 2654435769U) >> _shift);
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	size_type findEmptySlot(size_type hash) const;
+	void rehash(size_type newCapacity);
+	void eraseSlot(size_type ctr);
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != 0);
+			assert(_idx <= _hashmap->_mask);
+			assert(isUsed(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_slots[_idx]._node;
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(0) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !isUsed(_hashmap->_ctrl[_idx]));
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isUsed(_ctrl[ctr]))
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (isUsed(_ctrl[ctr]))
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating empty storage for the given number of
+ * slots, which must be a power of two.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+	_ctrl = new byte[capacity];
+	assert(_ctrl != NULL);
+	memset(_ctrl, kCtrlEmpty, capacity);
+
+	_slots = (Slot *)malloc(capacity * sizeof(Slot));
+	assert(_slots != NULL);
+
+	_mask = capacity - 1;
+	_shift = 32;
+	while (capacity > 1) {
+		capacity >>= 1;
+		_shift--;
+	}
+
+	_size = 0;
+	_erased = 0;
+}
+
+/**
+ * Internal method for destroying all entries and freeing the storage.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr]))
+			_slots[ctr]._node.~Node();
+	}
+
+	delete[] _ctrl;
+	free(_slots);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Simply clone the map given to us, slot by slot.
+	memcpy(_ctrl, map._ctrl, _mask + 1);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr])) {
+			_slots[ctr]._hash = map._slots[ctr]._hash;
+			new ((void *)&_slots[ctr]._node) Node(map._slots[ctr]._node);
+		}
+	}
+
+	_size = map._size;
+	_erased = map._erased;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+		return;
+	}
+
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr]))
+			_slots[ctr]._node.~Node();
+	}
+	memset(_ctrl, kCtrlEmpty, _mask + 1);
+
+	_size = 0;
+	_erased = 0;
+}
+
+/**
+ * Internal method for moving all entries into new storage with the given
+ * number of slots. This also gets rid of all erased slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	const size_type oldSize = _size;
+	const size_type oldMask = _mask;
+	byte *oldCtrl = _ctrl;
+	Slot *oldSlots = _slots;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (!isUsed(oldCtrl[ctr]))
+			continue;
+
+		// The keys are known to be unique and the hash is stored along
+		// with them, so neither _hash() nor _equal() need to be called.
+		const size_type hash = oldSlots[ctr]._hash;
+		const size_type idx = findEmptySlot(hash);
+
+		_ctrl[idx] = oldCtrl[ctr];
+		_slots[idx]._hash = hash;
+		new ((void *)&_slots[idx]._node) Node(oldSlots[ctr]._node);
+		oldSlots[ctr]._node.~Node();
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	assert(_size == oldSize);
+
+	delete[] oldCtrl;
+	free(oldSlots);
+}
+
+/**
+ * Internal method returning the slot holding the given key, or -1 if the
+ * key is not contained in the map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const size_type hash = _hash(key);
+	const byte ctrl = ctrlForHash(hash);
+	size_type ctr = homeSlot(hash);
+
+	// Linear probing keeps the search within a few cache lines. There is
+	// always at least one empty slot, which ends it.
+	while (_ctrl[ctr] != kCtrlEmpty) {
+		if (_ctrl[ctr] == ctrl && _equal(_slots[ctr]._node._key, key))
+			return ctr;
+
+		ctr = (ctr + 1) & _mask;
+	}
+
+	return (size_type)-1;
+}
+
+/**
+ * Internal method returning the first empty slot on the probe sequence of the
+ * given hash.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findEmptySlot(size_type hash) const {
+	size_type ctr = homeSlot(hash);
+	while (_ctrl[ctr] != kCtrlEmpty)
+		ctr = (ctr + 1) & _mask;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type hash = _hash(key);
+	const byte ctrl = ctrlForHash(hash);
+	size_type ctr = homeSlot(hash);
+	size_type firstErased = (size_type)-1;
+
+	while (_ctrl[ctr] != kCtrlEmpty) {
+		if (_ctrl[ctr] == ctrl) {
+			if (_equal(_slots[ctr]._node._key, key))
+				return ctr;
+		} else if (_ctrl[ctr] == kCtrlErased && firstErased == (size_type)-1) {
+			firstErased = ctr;
+		}
+
+		ctr = (ctr + 1) & _mask;
+	}
+
+	if (firstErased != (size_type)-1) {
+		// Reusing an erased slot does not change the load of the map
+		ctr = firstErased;
+		_erased--;
+	} else {
+		// Keep the load factor below a certain threshold.
+		// Erased slots are also counted
+		const size_type capacity = _mask + 1;
+		if ((_size + _erased + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR >
+		        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+			// Only grow when the entries actually in use need the room;
+			// otherwise getting rid of the erased slots is enough.
+			if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR >
+			        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+				rehash(capacity * 2);
+			else
+				rehash(capacity);
+
+			ctr = findEmptySlot(hash);
+		}
+	}
+
+	_ctrl[ctr] = ctrl;
+	_slots[ctr]._hash = hash;
+	new ((void *)&_slots[ctr]._node) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._node._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._node._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._node._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type ctr) {
+	assert(ctr <= _mask);
+	assert(isUsed(_ctrl[ctr]));
+
+	// Lookups must continue past the slot, so it is marked as erased
+	// instead of empty.
+	_slots[ctr]._node.~Node();
+	_ctrl[ctr] = kCtrlErased;
+	_size--;
+	_erased++;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	eraseSlot(entry._idx);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		eraseSlot(ctr);
+}
+
+} // End of namespace Common
+
+#endif
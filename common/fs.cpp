@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/endian.h"
+#include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "backends/fs/abstract-fs.h"
@@ -69,6 +71,15 @@ FSNode FSNode::getChild(const String &n) const {
 	return FSNode(node);
 }
 
+FSNode FSNode::getKnownChild(const String &n, bool isDirectory) const {
+	// If this node is invalid or not a directory, return an invalid node
+	if (_realNode == 0 || !_realNode->isDirectory())
+		return FSNode();
+
+	AbstractFSNode *node = _realNode->getKnownChild(n, isDirectory);
+	return FSNode(node);
+}
+
 bool FSNode::getChildren(FSList &fslist, ListMode mode, bool hidden) const {
 	if (!_realNode || !_realNode->isDirectory())
 		return false;
@@ -125,6 +136,14 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+bool FSNode::getModificationTime(uint32 &time) const {
+	return _realNode && _realNode->getModificationTime(time);
+}
+
+bool FSNode::getFileSize(uint32 &size) const {
+	return _realNode && _realNode->getFileSize(size);
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == 0)
 		return 0;
@@ -153,21 +172,21 @@ WriteStream *FSNode::createWriteStream() const {
 }
 
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat)
-  : _node(node), _cached(false), _depth(depth), _flat(flat) {
+  : _node(node), _cached(false), _depth(depth), _flat(flat), _useIndex(false) {
 }
 
 FSDirectory::FSDirectory(const String &prefix, const FSNode &node, int depth, bool flat)
-  : _node(node), _cached(false), _depth(depth), _flat(flat) {
+  : _node(node), _cached(false), _depth(depth), _flat(flat), _useIndex(false) {
 
 	setPrefix(prefix);
 }
 
 FSDirectory::FSDirectory(const String &name, int depth, bool flat)
-  : _node(name), _cached(false), _depth(depth), _flat(flat) {
+  : _node(name), _cached(false), _depth(depth), _flat(flat), _useIndex(false) {
 }
 
 FSDirectory::FSDirectory(const String &prefix, const String &name, int depth, bool flat)
-  : _node(name), _cached(false), _depth(depth), _flat(flat) {
+  : _node(name), _cached(false), _depth(depth), _flat(flat), _useIndex(false) {
 
 	setPrefix(prefix);
 }
@@ -186,18 +205,40 @@ FSNode FSDirectory::getFSNode() const {
 	return _node;
 }
 
+void FSDirectory::setIndexFile(const FSNode &file) {
+	_indexFile = file;
+	_useIndex = true;
+}
+
 FSNode *FSDirectory::lookupCache(NodeCache &cache, const String &name) const {
 	// make caching as lazy as possible
 	if (!name.empty()) {
 		ensureCached();
 
-		if (cache.contains(name))
-			return &cache[name];
+		NodeCache::iterator it = cache.find(name);
+		if (it != cache.end())
+			return &it->_value;
 	}
 
 	return 0;
 }
 
+FSNode *FSDirectory::lookupFileCache(const Atom &name) const {
+	if (name.empty())
+		return 0;
+
+	ensureCached();
+
+	// Once looked up, the result for an Atom is a pointer hash probe away
+	AtomCache::const_iterator it = _atomFileCache.find(name);
+	if (it != _atomFileCache.end())
+		return it->_value;
+
+	FSNode *node = lookupCache(_fileCache, name.toString());
+	_atomFileCache[name] = node;
+	return node;
+}
+
 bool FSDirectory::hasFile(const String &name) const {
 	if (name.empty() || !_node.isDirectory())
 		return false;
@@ -206,6 +247,14 @@ bool FSDirectory::hasFile(const String &name) const {
 	return node && node->exists();
 }
 
+bool FSDirectory::hasFileAtom(const Atom &name) const {
+	if (name.empty() || !_node.isDirectory())
+		return false;
+
+	FSNode *node = lookupFileCache(name);
+	return node && node->exists();
+}
+
 const ArchiveMemberPtr FSDirectory::getMember(const String &name) const {
 	if (name.empty() || !_node.isDirectory())
 		return ArchiveMemberPtr();
@@ -237,6 +286,20 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const String &name) c
 	return stream;
 }
 
+SeekableReadStream *FSDirectory::createReadStreamForMemberAtom(const Atom &name) const {
+	if (name.empty() || !_node.isDirectory())
+		return 0;
+
+	FSNode *node = lookupFileCache(name);
+	if (!node)
+		return 0;
+	SeekableReadStream *stream = node->createReadStream();
+	if (!stream)
+		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", name.c_str());
+
+	return stream;
+}
+
 FSDirectory *FSDirectory::getSubDirectory(const String &name, int depth, bool flat) {
 	return getSubDirectory(String(), name, depth, flat);
 }
@@ -252,12 +315,125 @@ FSDirectory *FSDirectory::getSubDirectory(const String &prefix, const String &na
 	return new FSDirectory(prefix, *node, depth, flat);
 }
 
-void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String& prefix) const {
+enum {
+	kIndexVersion = 2
+};
+
+bool FSDirectory::loadIndex(DirectoryIndex &index) const {
+	if (!_indexFile.exists())
+		return false;
+
+	SeekableReadStream *stream = _indexFile.createReadStream();
+	if (!stream)
+		return false;
+
+	if (stream->readUint32BE() != MKTAG('F', 'S', 'I', 'X') || stream->readUint32BE() != kIndexVersion) {
+		delete stream;
+		return false;
+	}
+
+	bool valid = true;
+	const uint32 scanStart = stream->readUint32BE();
+	uint32 directories = stream->readUint32BE();
+	for (uint32 i = 0; i < directories && valid; i++) {
+		String path;
+		char c;
+		while ((c = stream->readByte()) != 0 && !stream->eos())
+			path += c;
+
+		IndexedDirectory &dir = index[path];
+		dir._time = stream->readUint32BE();
+
+		// Every entry takes at least two bytes
+		const uint32 entries = stream->readUint32BE();
+		valid = !stream->eos() && entries <= (uint32)(stream->size() - stream->pos()) / 2;
+		if (!valid)
+			break;
+
+		dir._entries.resize(entries);
+		for (uint j = 0; j < entries && !stream->eos(); j++) {
+			IndexedEntry &entry = dir._entries[j];
+			while ((c = stream->readByte()) != 0 && !stream->eos())
+				entry._name += c;
+			entry._isDirectory = stream->readByte() != 0;
+		}
+
+		// Modification times only have a resolution of seconds. A directory
+		// modified in the second the scan started or later may have changed
+		// again after it was listed without its time changing, so it needs to
+		// be listed again.
+		if (dir._time >= scanStart)
+			index.erase(path);
+	}
+
+	valid = valid && !stream->eos() && !stream->err();
+	delete stream;
+
+	if (!valid) {
+		warning("FSDirectory::loadIndex: '%s' is corrupt", _indexFile.getName().c_str());
+		index.clear();
+	}
+	return valid;
+}
+
+void FSDirectory::saveIndex(WriteStream *stream, uint32 scanStart, const DirectoryIndex &index) const {
+	stream->writeUint32BE(MKTAG('F', 'S', 'I', 'X'));
+	stream->writeUint32BE(kIndexVersion);
+	stream->writeUint32BE(scanStart);
+	stream->writeUint32BE(index.size());
+	for (DirectoryIndex::const_iterator it = index.begin(); it != index.end(); ++it) {
+		stream->writeString(it->_key);
+		stream->writeByte(0);
+		stream->writeUint32BE(it->_value._time);
+		stream->writeUint32BE(it->_value._entries.size());
+		for (uint i = 0; i < it->_value._entries.size(); i++) {
+			stream->writeString(it->_value._entries[i]._name);
+			stream->writeByte(0);
+			stream->writeByte(it->_value._entries[i]._isDirectory);
+		}
+	}
+
+	stream->finalize();
+	if (stream->err())
+		warning("FSDirectory::saveIndex: Can't write '%s'", _indexFile.getName().c_str());
+	delete stream;
+}
+
+void FSDirectory::listDirectory(const FSNode &node, FSList &list, IndexUpdate *index) const {
+	uint32 time;
+	if (!index || !node.getModificationTime(time)) {
+		node.getChildren(list, FSNode::kListAll, true);
+		return;
+	}
+
+	const String path = node.getPath();
+	DirectoryIndex::const_iterator it = index->_old.find(path);
+	if (it != index->_old.end() && it->_value._time == time) {
+		const Array<IndexedEntry> &entries = it->_value._entries;
+		for (uint i = 0; i < entries.size(); i++)
+			list.push_back(node.getKnownChild(entries[i]._name, entries[i]._isDirectory));
+
+		index->_new[path] = it->_value;
+		return;
+	}
+
+	node.getChildren(list, FSNode::kListAll, true);
+
+	IndexedDirectory &dir = index->_new[path];
+	dir._time = time;
+	dir._entries.resize(list.size());
+	for (uint i = 0; i < list.size(); i++) {
+		dir._entries[i]._name = list[i].getName();
+		dir._entries[i]._isDirectory = list[i].isDirectory();
+	}
+}
+
+void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String& prefix, IndexUpdate *index) const {
 	if (depth <= 0)
 		return;
 
 	FSList list;
-	node.getChildren(list, FSNode::kListAll, true);
+	listDirectory(node, list, index);
 
 	FSList::iterator it = list.begin();
 	for ( ; it != list.end(); ++it) {
@@ -275,7 +451,7 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String&
 				if (_subDirCache.contains(lowercaseName)) {
 					warning("FSDirectory::cacheDirectory: name clash when building subDirCache with subdirectory '%s'", name.c_str());
 				}
-				cacheDirectoryRecursive(*it, depth - 1, _flat ? prefix : lowercaseName + "/");
+				cacheDirectoryRecursive(*it, depth - 1, _flat ? prefix : lowercaseName + "/", index);
 				_subDirCache[lowercaseName] = *it;
 			}
 		} else {
@@ -292,7 +468,29 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const String&
 void FSDirectory::ensureCached() const  {
 	if (_cached)
 		return;
-	cacheDirectoryRecursive(_node, _depth, _prefix);
+
+	WriteStream *stream = 0;
+	IndexUpdate index;
+	uint32 scanStart;
+	if (_useIndex) {
+		loadIndex(index._old);
+
+		// The index file is rewritten on every scan: truncating it up front
+		// stamps it with the time the scan started, in the same clock as the
+		// modification times of the directories.
+		stream = _indexFile.createWriteStream();
+		if (stream && !_indexFile.getModificationTime(scanStart)) {
+			delete stream;
+			stream = 0;
+		}
+	}
+
+	if (stream) {
+		cacheDirectoryRecursive(_node, _depth, _prefix, &index);
+		saveIndex(stream, scanStart, index._new);
+	} else {
+		cacheDirectoryRecursive(_node, _depth, _prefix, 0);
+	}
 	_cached = true;
 }
 
@@ -129,6 +129,17 @@ public:
 	 */
 	FSNode getChild(const String &name) const;
 
+	/**
+	 * Same as getChild, for a child which is known to exist and to be a
+	 * directory or not, e.g. because it was listed by getChildren before.
+	 * Some backends can then avoid querying the filesystem for it.
+	 *
+	 * @param name			the name of a child of this directory
+	 * @param isDirectory	whether the child is a directory
+	 * @return the node referring to the child with the given name
+	 */
+	FSNode getKnownChild(const String &name, bool isDirectory) const;
+
 	/**
 	 * Return a list of all child nodes of this directory node. If called on a node
 	 * that does not represent a directory, false is returned.
@@ -213,6 +224,23 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Get the time the object referred by this node was last modified, in
+	 * seconds. For directories, this changes whenever entries are added,
+	 * removed or renamed. Not all backends support this.
+	 *
+	 * @return true if the time is known, false otherwise.
+	 */
+	bool getModificationTime(uint32 &time) const;
+
+	/**
+	 * Get the size of the file referred by this node, in bytes, without
+	 * opening it. Not all backends support this.
+	 *
+	 * @return true if the size is known, false otherwise.
+	 */
+	bool getFileSize(uint32 &size) const;
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -280,11 +308,41 @@ class FSDirectory : public Archive {
 	mutable int	_depth;
 	mutable bool _flat;
 
+	// Files looked up by Atom, pointing into _fileCache, or 0 for files
+	// which do not exist. Only names the caller interned end up in here.
+	typedef HashMap<Atom, FSNode *> AtomCache;
+	mutable AtomCache	_atomFileCache;
+
 	// look for a match
 	FSNode *lookupCache(NodeCache &cache, const String &name) const;
+	FSNode *lookupFileCache(const Atom &name) const;
+
+	// Persistent index of directory listings, keyed by directory path
+	struct IndexedEntry {
+		String _name;
+		bool _isDirectory;
+	};
+	struct IndexedDirectory {
+		uint32 _time;	// modification time of the directory when it was listed
+		Array<IndexedEntry> _entries;
+	};
+	typedef HashMap<String, IndexedDirectory> DirectoryIndex;
+	struct IndexUpdate {
+		DirectoryIndex _old, _new;
+	};
+
+	FSNode	_indexFile;
+	bool	_useIndex;
+
+	bool loadIndex(DirectoryIndex &index) const;
+	// writes the index to stream and takes ownership of it
+	void saveIndex(WriteStream *stream, uint32 scanStart, const DirectoryIndex &index) const;
+
+	// list a directory, from the index if it is still up to date
+	void listDirectory(const FSNode &node, FSList &list, IndexUpdate *index) const;
 
 	// cache management
-	void cacheDirectoryRecursive(FSNode node, int depth, const String& prefix) const;
+	void cacheDirectoryRecursive(FSNode node, int depth, const String& prefix, IndexUpdate *index) const;
 
 	// fill cache if not already cached
 	void ensureCached() const;
@@ -314,6 +372,16 @@ public:
 	 */
 	FSNode getFSNode() const;
 
+	/**
+	 * Keep the listings of the directory tree in the given file across runs.
+	 * When the cache is built, directories whose modification time did not
+	 * change since they were listed are taken from the file instead of being
+	 * scanned again, and the file is rewritten with the result. Has no
+	 * effect on backends which cannot tell the modification time of
+	 * directories, or once the cache has been built.
+	 */
+	void setIndexFile(const FSNode &file);
+
 	/**
 	 * Create a new FSDirectory pointing to a sub directory of the instance. See class comment
 	 * for an explanation of the prefix parameter.
@@ -349,6 +417,13 @@ public:
 	 * for success.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	using Archive::hasFile;
+	using Archive::createReadStreamForMember;
+
+protected:
+	virtual bool hasFileAtom(const Atom &name) const;
+	virtual SeekableReadStream *createReadStreamForMemberAtom(const Atom &name) const;
 };
 
 
@@ -23,6 +23,7 @@
 #ifndef COMMON_HASH_STR_H
 #define COMMON_HASH_STR_H
 
+#include "common/atom.h"
 #include "common/hashmap.h"
 #include "common/str.h"
 
@@ -47,10 +48,12 @@ struct CaseSensitiveString_Hash {
 
 struct IgnoreCase_EqualTo {
 	bool operator()(const String& x, const String& y) const { return x.equalsIgnoreCase(y); }
+	bool operator()(const Atom& x, const Atom& y) const { return x == y; }
 };
 
 struct IgnoreCase_Hash {
 	uint operator()(const String& x) const { return hashit_lower(x.c_str()); }
+	uint operator()(const Atom& x) const { return x.hash(); }
 };
 
 
@@ -68,6 +71,14 @@ struct Hash<String> {
 	}
 };
 
+// Atoms are case insensitive, so this is the same as IgnoreCase_Hash.
+template<>
+struct Hash<Atom> {
+	uint operator()(const Atom& a) const {
+		return a.hash();
+	}
+};
+
 template<>
 struct Hash<const char *> {
 	uint operator()(const char *s) const {
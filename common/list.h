@@ -30,9 +30,11 @@ namespace Common {
 /**
  * Simple double linked list, modeled after the list template of the standard
  * C++ library.
+ *
+ * The nodes are obtained from the given Allocator, see DefaultAllocator.
  */
-template<typename t_T>
-class List {
+template<typename t_T, class Allocator = DefaultAllocator>
+class List : private Allocator {
 protected:
 	typedef ListInternal::NodeBase		NodeBase;
 	typedef ListInternal::Node<t_T>		Node;
@@ -51,7 +53,15 @@ public:
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 	}
-	List(const List<t_T> &list) {
+	/**
+	 * Constructs an empty list which obtains its nodes from the given
+	 * allocator.
+	 */
+	explicit List(const Allocator &allocator) : Allocator(allocator) {
+		_anchor._prev = &_anchor;
+		_anchor._next = &_anchor;
+	}
+	List(const List &list) : Allocator(list.getAllocator()) {
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 
@@ -163,7 +173,7 @@ public:
 		return static_cast<Node *>(_anchor._prev)->_data;
 	}
 
-	List<t_T> &operator=(const List<t_T> &list) {
+	List &operator=(const List &list) {
 		if (this != &list) {
 			iterator i;
 			const iterator e = end();
@@ -195,7 +205,7 @@ public:
 		while (pos != &_anchor) {
 			Node *node = static_cast<Node *>(pos);
 			pos = pos->_next;
-			delete node;
+			destroyNode(node);
 		}
 
 		_anchor._prev = &_anchor;
@@ -237,7 +247,7 @@ protected:
 		Node *node = static_cast<Node *>(pos);
 		n._prev->_next = n._next;
 		n._next->_prev = n._prev;
-		delete node;
+		destroyNode(node);
 		return n;
 	}
 
@@ -245,14 +255,25 @@ protected:
 	 * Inserts element before pos.
 	 */
 	void insert(NodeBase *pos, const t_T &element) {
-		ListInternal::NodeBase *newNode = new Node(element);
-		assert(newNode);
+		void *memory = getAllocator().allocate(sizeof(Node));
+		assert(memory);
+		ListInternal::NodeBase *newNode = new (memory) Node(element);
 
 		newNode->_next = pos;
 		newNode->_prev = pos->_prev;
 		newNode->_prev->_next = newNode;
 		newNode->_next->_prev = newNode;
 	}
+
+	void destroyNode(Node *node) {
+		node->~Node();
+		getAllocator().deallocate(node);
+	}
+
+	// The allocator is a base class rather than a member, so that empty
+	// allocators do not take up any space
+	Allocator &getAllocator() { return *this; }
+	const Allocator &getAllocator() const { return *this; }
 };
 
 } // End of namespace Common
@@ -23,13 +23,11 @@
 #ifndef COMMON_LIST_INTERN_H
 #define COMMON_LIST_INTERN_H
 
+#include "common/memory.h"
 #include "common/scummsys.h"
 
 namespace Common {
 
-template<typename T> class List;
-
-
 namespace ListInternal {
 	struct NodeBase {
 		NodeBase *_prev;
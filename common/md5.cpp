@@ -79,9 +79,11 @@ static void md5_process(md5_context *ctx, const uint8 data[64]) {
 
 #define S(x, n) ((x << n) | ((x & 0xFFFFFFFF) >> (32 - n)))
 
-#define P(a, b, c, d, k, s, t)                    \
-{                                                 \
-	a += F(b,c,d) + X[k] + t; a = S(a,s) + b; \
+// X[k] + t does not depend on the previous step, so it is added first to
+// keep it off the critical path
+#define P(a, b, c, d, k, s, t)                        \
+{                                                     \
+	a += X[k] + t; a += F(b,c,d); a = S(a,s) + b; \
 }
 
 	A = ctx->state[0];
@@ -110,7 +112,9 @@ static void md5_process(md5_context *ctx, const uint8 data[64]) {
 
 #undef F
 
-#define F(x, y, z) (y ^ (z & (x ^ y)))
+// The two terms have no bits in common, so they can be added. Unlike with
+// the usual y ^ (z & (x ^ y)), both only depend on one of the previous results.
+#define F(x, y, z) ((x & z) + (y & ~z))
 
 	P(A, B, C, D,  1,  5, 0xF61E2562);
 	P(D, A, B, C,  6,  9, 0xC040B340);
@@ -251,7 +255,9 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length) {
 #else
 	md5_context ctx;
 	int i;
-	unsigned char buf[1000];
+	// A multiple of the block size, so that md5_update can hash straight
+	// from the buffer
+	unsigned char buf[4096];
 	bool restricted = (length != 0);
 	uint32 readlen;
 
@@ -281,15 +287,19 @@ bool computeStreamMD5(ReadStream &stream, uint8 digest[16], uint32 length) {
 }
 
 String computeStreamMD5AsString(ReadStream &stream, uint32 length) {
-	String md5;
+	static const char hexDigits[] = "0123456789abcdef";
 	uint8 digest[16];
-	if (computeStreamMD5(stream, digest, length)) {
-		for (int i = 0; i < 16; i++) {
-			md5 += String::format("%02x", (int)digest[i]);
-		}
+	char md5[33];
+	if (!computeStreamMD5(stream, digest, length))
+		return String();
+
+	for (int i = 0; i < 16; i++) {
+		md5[2 * i] = hexDigits[digest[i] >> 4];
+		md5[2 * i + 1] = hexDigits[digest[i] & 0xF];
 	}
+	md5[32] = 0;
 
-	return md5;
+	return String(md5);
 }
 
 } // End of namespace Common
@@ -61,6 +61,20 @@ void uninitialized_fill_n(Type *dst, size_t n, const Value &x) {
 		new ((void *)dst++) Type(x);
 }
 
+/**
+ * The allocator used by containers like Array and List unless another one
+ * is specified. It gets its memory from malloc().
+ *
+ * Allocators are passed to the constructor of a container, and copied along
+ * with it. They need to provide allocate(), which returns memory suitable
+ * for any type, or 0 on failure, and deallocate(). See ArenaAllocator for an
+ * allocator with state.
+ */
+struct DefaultAllocator {
+	void *allocate(size_t size) { return malloc(size); }
+	void deallocate(void *ptr) { free(ptr); }
+};
+
 } // End of namespace Common
 
 #endif
@@ -23,6 +23,7 @@
 #ifndef COMMON_MEMSTREAM_H
 #define COMMON_MEMSTREAM_H
 
+#include "common/bytecursor.h"
 #include "common/stream.h"
 #include "common/types.h"
 #include "common/util.h"
@@ -71,6 +72,12 @@ public:
 	int32 size() const { return _size; }
 
 	bool seek(int32 offs, int whence = SEEK_SET);
+
+	bool getCursor(ByteCursor &cursor) const {
+		cursor = ByteCursor(_ptrOrig, _size);
+		cursor.seek(_pos);
+		return true;
+	}
 };
 
 
@@ -2,10 +2,13 @@ MODULE := common
 
 MODULE_OBJS := \
 	archive.o \
+	arena.o \
+	atom.o \
 	config-manager.o \
 	coroutines.o \
 	dcl.o \
 	debug.o \
+	endian.o \
 	error.o \
 	EventDispatcher.o \
 	EventMapper.o \
@@ -29,6 +32,7 @@ MODULE_OBJS := \
 	random.o \
 	rational.o \
 	rendermode.o \
+	savecontainer.o \
 	str.o \
 	stream.o \
 	system.o \
@@ -0,0 +1,412 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/savecontainer.h"
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+#include "common/zlib.h"
+
+namespace Common {
+
+enum {
+	kContainerTag = MKTAG('S','C','N','T'),
+	kContainerEndTag = MKTAG('S','E','N','D'),
+	kContainerVersion = 1,
+
+	kHeaderSize = 16,
+	kTrailerSize = 16,
+	kIndexEntrySize = 12,
+	kMaxBlockSize = 16 * 1024 * 1024,
+
+	kMethodStore = 0,
+	kMethodDeflate = 1,
+
+	kNoBlock = 0xFFFFFFFF
+};
+
+SaveContainerWriteStream::SaveContainerWriteStream(WriteStream *toBeWrapped, int level, bool dedup)
+	: _wrapped(toBeWrapped), _level(CLIP<int>(level, kSaveCompressionStore, kSaveCompressionBest)), _dedup(dedup),
+	  _metaEnded(false), _finalized(false), _err(false), _meta(new MemoryWriteStreamDynamic(DisposeAfterUse::YES)),
+	  _block(0), _blockFill(0), _compressed(0), _filePos(0), _bodySize(0), _metaSize(0) {
+	assert(toBeWrapped);
+#if !defined(USE_ZLIB)
+	_level = kSaveCompressionStore;
+#endif
+}
+
+SaveContainerWriteStream::~SaveContainerWriteStream() {
+	finalize();
+	delete[] _block;
+	delete[] _compressed;
+}
+
+void SaveContainerWriteStream::writeHeader(uint32 metaSize) {
+	_wrapped->writeUint32BE(kContainerTag);
+	_wrapped->writeUint16BE(kContainerVersion);
+	_wrapped->writeUint16BE(0);
+	_wrapped->writeUint32BE(metaSize);
+	_wrapped->writeUint32BE(kBlockSize);
+	_filePos = kHeaderSize;
+}
+
+void SaveContainerWriteStream::endMetadata() {
+	if (_metaEnded)
+		return;
+
+	_metaEnded = true;
+	_metaSize = _meta->size();
+	writeHeader(_metaSize);
+	if (_wrapped->write(_meta->getData(), _metaSize) != _metaSize)
+		_err = true;
+	_filePos += _metaSize;
+	_meta.reset();
+}
+
+void SaveContainerWriteStream::writeBody(const byte *data, uint32 dataSize) {
+	while (dataSize) {
+		if (!_block)
+			_block = new byte[kBlockSize];
+
+		const uint32 n = MIN<uint32>(kBlockSize - _blockFill, dataSize);
+		memcpy(_block + _blockFill, data, n);
+		_blockFill += n;
+		_bodySize += n;
+		data += n;
+		dataSize -= n;
+
+		if (_blockFill == kBlockSize)
+			flushBlock();
+	}
+}
+
+void SaveContainerWriteStream::flushBlock() {
+	String digest;
+	if (_dedup) {
+		MemoryReadStream stream(_block, _blockFill);
+		digest = computeStreamMD5AsString(stream);
+
+		BlockMap::const_iterator i = _blockMap.find(digest);
+		if (i != _blockMap.end()) {
+			// Refer to the earlier copy of this block
+			_blocks.push_back(_blocks[i->_value]);
+			_blockFill = 0;
+			return;
+		}
+	}
+
+	BlockEntry entry;
+	entry._offset = _filePos;
+	entry._method = kMethodStore;
+	const byte *data = _block;
+	uint32 size = _blockFill;
+
+#if defined(USE_ZLIB)
+	if (_level != kSaveCompressionStore) {
+		if (!_compressed)
+			_compressed = new byte[kBlockSize];
+
+		// Blocks which do not get smaller are stored as they are
+		unsigned long compressedSize = _blockFill - 1;
+		if (compress(_compressed, &compressedSize, _block, _blockFill, _level)) {
+			entry._method = kMethodDeflate;
+			data = _compressed;
+			size = compressedSize;
+		}
+	}
+#endif
+
+	entry._storedSize = size;
+	if (_wrapped->write(data, size) != size)
+		_err = true;
+	_filePos += size;
+
+	if (_dedup)
+		_blockMap[digest] = _blocks.size();
+	_blocks.push_back(entry);
+	_blockFill = 0;
+}
+
+bool SaveContainerWriteStream::err() const {
+	return _err || _wrapped->err();
+}
+
+void SaveContainerWriteStream::clearErr() {
+	_err = false;
+	_wrapped->clearErr();
+}
+
+void SaveContainerWriteStream::finalize() {
+	if (_finalized)
+		return;
+	_finalized = true;
+
+	if (!_metaEnded) {
+		// Without a metadata block, everything goes into the body
+		ScopedPtr<MemoryWriteStreamDynamic> data(_meta.release());
+		_metaEnded = true;
+		writeHeader(0);
+		writeBody(data->getData(), data->size());
+	}
+
+	if (_blockFill)
+		flushBlock();
+
+	const uint32 indexOffset = _filePos;
+	for (uint i = 0; i < _blocks.size(); ++i) {
+		_wrapped->writeUint32BE(_blocks[i]._offset);
+		_wrapped->writeUint32BE(_blocks[i]._storedSize);
+		_wrapped->writeUint32BE(_blocks[i]._method);
+	}
+
+	_wrapped->writeUint32BE(_bodySize);
+	_wrapped->writeUint32BE(_blocks.size());
+	_wrapped->writeUint32BE(indexOffset);
+	_wrapped->writeUint32BE(kContainerEndTag);
+
+	_wrapped->finalize();
+}
+
+uint32 SaveContainerWriteStream::write(const void *dataPtr, uint32 dataSize) {
+	if (_finalized || err())
+		return 0;
+
+	if (!_metaEnded)
+		return _meta->write(dataPtr, dataSize);
+
+	writeBody((const byte *)dataPtr, dataSize);
+	return err() ? 0 : dataSize;
+}
+
+int32 SaveContainerWriteStream::pos() const {
+	if (!_metaEnded)
+		return _meta->pos();
+	return _metaSize + _bodySize;
+}
+
+SaveContainerReadStream::SaveContainerReadStream(SeekableReadStream *toBeWrapped)
+	: _wrapped(toBeWrapped), _start(0), _metaSize(0), _blockSize(0), _pos(0), _eos(false), _err(false),
+	  _indexLoaded(false), _indexErr(false), _bodySize(0),
+	  _block(0), _compressed(0), _cachedBlock(kNoBlock), _cachedBlockSize(0) {
+	assert(toBeWrapped);
+
+	_start = _wrapped->pos();
+	const uint32 tag = _wrapped->readUint32BE();
+	const uint16 version = _wrapped->readUint16BE();
+	_wrapped->readUint16BE();
+	_metaSize = _wrapped->readUint32BE();
+	_blockSize = _wrapped->readUint32BE();
+
+	if (_wrapped->eos() || _wrapped->err() || tag != kContainerTag || version > kContainerVersion
+	    || _blockSize == 0 || _blockSize > kMaxBlockSize) {
+		_metaSize = 0;
+		_err = true;
+	}
+}
+
+SaveContainerReadStream::~SaveContainerReadStream() {
+	delete[] _block;
+	delete[] _compressed;
+}
+
+bool SaveContainerReadStream::loadIndex() const {
+	if (_indexLoaded)
+		return !_indexErr;
+
+	_indexLoaded = true;
+	_indexErr = true;
+
+	if (!_wrapped->seek(-(int32)kTrailerSize, SEEK_END) || _wrapped->pos() < _start)
+		return false;
+
+	const uint32 trailerOffset = _wrapped->pos() - _start;
+	_bodySize = _wrapped->readUint32BE();
+	const uint32 count = _wrapped->readUint32BE();
+	const uint32 indexOffset = _wrapped->readUint32BE();
+	const uint32 tag = _wrapped->readUint32BE();
+	if (_wrapped->eos() || _wrapped->err() || tag != kContainerEndTag
+	    || count != _bodySize / _blockSize + (_bodySize % _blockSize != 0 ? 1 : 0))
+		return false;
+
+	// The index sits between indexOffset and the trailer; check that before
+	// allocating anything for it
+	if (indexOffset > trailerOffset || count > (trailerOffset - indexOffset) / kIndexEntrySize)
+		return false;
+
+	if (!_wrapped->seek(_start + indexOffset))
+		return false;
+
+	_blocks.resize(count);
+	for (uint32 i = 0; i < count; ++i) {
+		_blocks[i]._offset = _wrapped->readUint32BE();
+		_blocks[i]._storedSize = _wrapped->readUint32BE();
+		_blocks[i]._method = _wrapped->readUint32BE();
+	}
+
+	if (_wrapped->eos() || _wrapped->err()) {
+		_blocks.clear();
+		return false;
+	}
+
+	_indexErr = false;
+	return true;
+}
+
+bool SaveContainerReadStream::loadBlock(uint32 block) {
+	if (block == _cachedBlock)
+		return true;
+
+	_cachedBlock = kNoBlock;
+	if (block >= _blocks.size())
+		return false;
+
+	const BlockEntry &entry = _blocks[block];
+	const uint32 rawSize = MIN(_blockSize, _bodySize - block * _blockSize);
+
+	if (!_block)
+		_block = new byte[_blockSize];
+
+	if (!_wrapped->seek(_start + entry._offset))
+		return false;
+
+	if (entry._method == kMethodStore) {
+		if (entry._storedSize != rawSize || _wrapped->read(_block, rawSize) != rawSize)
+			return false;
+	} else if (entry._method == kMethodDeflate) {
+#if defined(USE_ZLIB)
+		if (entry._storedSize >= rawSize)
+			return false;
+
+		if (!_compressed)
+			_compressed = new byte[_blockSize];
+
+		if (_wrapped->read(_compressed, entry._storedSize) != entry._storedSize)
+			return false;
+
+		unsigned long size = rawSize;
+		if (!uncompress(_block, &size, _compressed, entry._storedSize) || size != rawSize)
+			return false;
+#else
+		warning("SaveContainerReadStream: Compressed savefile blocks require zlib support");
+		return false;
+#endif
+	} else {
+		return false;
+	}
+
+	_cachedBlock = block;
+	_cachedBlockSize = rawSize;
+	return true;
+}
+
+void SaveContainerReadStream::clearErr() {
+	_eos = false;
+	_err = false;
+	_wrapped->clearErr();
+}
+
+uint32 SaveContainerReadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 total = 0;
+
+	while (dataSize && !err()) {
+		uint32 n;
+
+		if (_pos < _metaSize) {
+			// The metadata is read straight from the wrapped stream
+			n = MIN(dataSize, _metaSize - _pos);
+			const int32 offset = _start + kHeaderSize + _pos;
+			if ((_wrapped->pos() != offset && !_wrapped->seek(offset)) || _wrapped->read(dst, n) != n) {
+				_err = true;
+				break;
+			}
+		} else {
+			if (!loadIndex()) {
+				_err = true;
+				break;
+			}
+
+			const uint32 bodyPos = _pos - _metaSize;
+			if (bodyPos >= _bodySize) {
+				_eos = true;
+				break;
+			}
+
+			const uint32 block = bodyPos / _blockSize;
+			if (!loadBlock(block)) {
+				_err = true;
+				break;
+			}
+
+			const uint32 offset = bodyPos - block * _blockSize;
+			n = MIN(dataSize, _cachedBlockSize - offset);
+			memcpy(dst, _block + offset, n);
+		}
+
+		dst += n;
+		dataSize -= n;
+		total += n;
+		_pos += n;
+	}
+
+	return total;
+}
+
+int32 SaveContainerReadStream::size() const {
+	if (!loadIndex())
+		return _metaSize;
+	return _metaSize + _bodySize;
+}
+
+bool SaveContainerReadStream::seek(int32 offset, int whence) {
+	int32 newPos;
+	switch (whence) {
+	case SEEK_END:
+		newPos = size() + offset;
+		break;
+	case SEEK_CUR:
+		newPos = _pos + offset;
+		break;
+	case SEEK_SET:
+	default:
+		newPos = offset;
+		break;
+	}
+
+	if (newPos < 0 || ((uint32)newPos > _metaSize && newPos > size()))
+		return false;
+
+	_pos = newPos;
+	_eos = false;
+	return true;
+}
+
+bool isSaveContainer(SeekableReadStream &stream) {
+	const int32 start = stream.pos();
+	const uint32 tag = stream.readUint32BE();
+	const bool eos = stream.eos();
+	stream.seek(start);
+	return !eos && tag == kContainerTag;
+}
+
+} // End of namespace Common
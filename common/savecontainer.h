@@ -0,0 +1,204 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SAVECONTAINER_H
+#define COMMON_SAVECONTAINER_H
+
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+
+namespace Common {
+
+/**
+ * Compression levels for savefile containers. Any zlib level between
+ * kSaveCompressionStore and kSaveCompressionBest may be used.
+ */
+enum SaveCompressionLevel {
+	kSaveCompressionStore = 0,		///< Store the body uncompressed
+	kSaveCompressionFast = 1,
+	kSaveCompressionDefault = 6,
+	kSaveCompressionBest = 9
+};
+
+/**
+ * Savefile containers split a savefile into two parts: a metadata block,
+ * which typically holds the engine's savegame header and thumbnail, and
+ * the body, which holds the actual game state.
+ *
+ * The metadata block is stored uncompressed right after a fixed size file
+ * header, so reading the header of a savegame never requires inflating
+ * anything. The body is cut into blocks which are compressed independently,
+ * with an index at the end of the file, so that only the blocks which are
+ * actually read get inflated, and seeking is cheap. Blocks with the same
+ * content are only stored once.
+ *
+ * When read back through wrapCompressedReadStream(), the metadata block and
+ * the body appear as one continuous stream, exactly as they were written.
+ * Thus, loading code does not need to know whether a savefile is stored in
+ * a container or not.
+ *
+ * Layout (all values big endian):
+ *   uint32  'SCNT'
+ *   uint16  version
+ *   uint16  flags (reserved, 0)
+ *   uint32  size of the metadata block
+ *   uint32  uncompressed size of all body blocks but the last one
+ *   ...     metadata block
+ *   ...     stored body blocks
+ *   ...     block index: per block its offset, stored size and method
+ *   uint32  uncompressed size of the body
+ *   uint32  number of blocks
+ *   uint32  offset of the block index
+ *   uint32  'SEND'
+ */
+class SaveContainerWriteStream : public WriteStream {
+public:
+	/**
+	 * Create a new container writer.
+	 *
+	 * @param toBeWrapped	the stream the container is written to, which
+	 *						becomes owned by the container writer
+	 * @param level			a zlib compression level for the body blocks,
+	 *						see SaveCompressionLevel
+	 * @param dedup			whether to store body blocks with the same
+	 *						content only once
+	 */
+	SaveContainerWriteStream(WriteStream *toBeWrapped, int level = kSaveCompressionFast, bool dedup = true);
+	~SaveContainerWriteStream();
+
+	/**
+	 * End the metadata block. Everything written before this call is stored
+	 * uncompressed in the metadata block, everything written afterwards in
+	 * the body. If this is never called, there is no metadata block, and
+	 * everything is stored in the body.
+	 */
+	void endMetadata();
+
+	virtual bool err() const;
+	virtual void clearErr();
+	virtual void finalize();
+	virtual uint32 write(const void *dataPtr, uint32 dataSize);
+	virtual int32 pos() const;
+
+private:
+	enum {
+		kBlockSize = 65536
+	};
+
+	struct BlockEntry {
+		uint32 _offset;
+		uint32 _storedSize;
+		uint32 _method;
+	};
+
+	typedef HashMap<String, uint32> BlockMap;
+
+	void writeHeader(uint32 metaSize);
+	void writeBody(const byte *data, uint32 dataSize);
+	void flushBlock();
+
+	ScopedPtr<WriteStream> _wrapped;
+	int _level;
+	bool _dedup;
+	bool _metaEnded;
+	bool _finalized;
+	bool _err;
+
+	ScopedPtr<MemoryWriteStreamDynamic> _meta;	///< The metadata, until endMetadata()
+	byte *_block;						///< The body block being filled
+	uint32 _blockFill;
+	byte *_compressed;
+	uint32 _filePos;					///< Position in the wrapped stream
+	uint32 _bodySize;
+	uint32 _metaSize;
+
+	Array<BlockEntry> _blocks;
+	BlockMap _blockMap;					///< MD5 of a block's content -> index
+};
+
+/**
+ * A stream reading a savefile container, see SaveContainerWriteStream.
+ * Only the parts of the container which are actually read are accessed:
+ * reading just the metadata never touches the body or its index.
+ */
+class SaveContainerReadStream : public SeekableReadStream {
+public:
+	/**
+	 * Create a new container reader. The wrapped stream must be positioned
+	 * at the start of the container, and becomes owned by the reader.
+	 */
+	explicit SaveContainerReadStream(SeekableReadStream *toBeWrapped);
+	~SaveContainerReadStream();
+
+	/** The size of the metadata block. */
+	uint32 getMetadataSize() const { return _metaSize; }
+
+	virtual bool err() const { return _err || _wrapped->err(); }
+	virtual void clearErr();
+	virtual bool eos() const { return _eos; }
+	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual int32 pos() const { return _pos; }
+	virtual int32 size() const;
+	virtual bool seek(int32 offset, int whence = SEEK_SET);
+
+private:
+	struct BlockEntry {
+		uint32 _offset;
+		uint32 _storedSize;
+		uint32 _method;
+	};
+
+	bool loadIndex() const;
+	bool loadBlock(uint32 block);
+
+	ScopedPtr<SeekableReadStream> _wrapped;
+	int32 _start;			///< Position of the container in the wrapped stream
+	uint32 _metaSize;
+	uint32 _blockSize;
+	uint32 _pos;
+	bool _eos;
+	bool _err;
+
+	mutable bool _indexLoaded;
+	mutable bool _indexErr;
+	mutable uint32 _bodySize;
+	mutable Array<BlockEntry> _blocks;
+
+	byte *_block;			///< The uncompressed content of _cachedBlock
+	byte *_compressed;
+	uint32 _cachedBlock;
+	uint32 _cachedBlockSize;
+};
+
+/**
+ * Check whether the given stream starts with a savefile container, without
+ * changing its position.
+ */
+bool isSaveContainer(SeekableReadStream &stream);
+
+} // End of namespace Common
+
+#endif
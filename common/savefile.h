@@ -29,6 +29,7 @@
 #include "common/str-array.h"
 #include "common/error.h"
 #include "common/ptr.h"
+#include "common/savecontainer.h"
 
 namespace Common {
 
@@ -48,11 +49,23 @@ typedef SeekableReadStream InSaveFile;
 class OutSaveFile: public WriteStream {
 protected:
 	ScopedPtr<WriteStream> _wrapped;
+	SaveContainerWriteStream *_container;
 
 public:
 	OutSaveFile(WriteStream *w);
+	OutSaveFile(SaveContainerWriteStream *w);
 	virtual ~OutSaveFile();
 
+	/**
+	 * End the metadata part of a savefile opened with
+	 * SaveFileManager::openContainerForSaving(). Everything written before
+	 * is stored uncompressed, so that it can be read back quickly. For other
+	 * savefiles, this does nothing.
+	 *
+	 * @see SaveContainerWriteStream::endMetadata
+	 */
+	void endMetadata();
+
 	virtual bool err() const;
 	virtual void clearErr();
 	virtual void finalize();
@@ -142,6 +155,25 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the savefile with the specified name in the given directory for
+	 * saving, in a savefile container (see SaveContainerWriteStream).
+	 *
+	 * Everything written before OutSaveFile::endMetadata() is called, which
+	 * should be the savegame header and thumbnail, is stored uncompressed at
+	 * the start of the file. Reading just that part back through
+	 * openForLoading() does not require decompressing the rest of the
+	 * savefile, which makes listing savegames with their descriptions and
+	 * thumbnails a lot cheaper for large savefiles.
+	 *
+	 * @param name   The name of the savefile.
+	 * @param level  The compression level of the body, see
+	 *               SaveCompressionLevel.
+	 * @param dedup  Whether to store identical blocks of the body only once.
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openContainerForSaving(const String &name, int level = kSaveCompressionFast, bool dedup = true);
+
 	/**
 	 * Open the file with the specified name in the given directory for loading.
 	 *
@@ -176,6 +208,15 @@ public:
 	 */
 	virtual bool renameSavefile(const String &oldName, const String &newName);
 
+	/**
+	 * Whether renameSavefile() moves savefiles without copying them. The
+	 * default implementation copies them through openForLoading() and
+	 * openForSaving(), which unpacks and recompresses them.
+	 *
+	 * @return true if renaming a savefile is cheap.
+	 */
+	virtual bool canRenameSavefiles() const { return false; }
+
 	/**
 	 * Copy the given savefile.
 	 *
@@ -440,6 +440,15 @@ public:
 		return MemoryReadStream(impl().data() + index, numEntries * sizeof(value_type), DisposeAfterUse::NO);
 	}
 
+	inline ByteCursor toCursor(const index_type index = 0, size_type numEntries = kSpanMaxSize) const {
+		if (numEntries == kSpanMaxSize) {
+			numEntries = impl().size();
+		}
+
+		impl().validate(index, numEntries * sizeof(value_type));
+		return ByteCursor((const byte *)(impl().data() + index), numEntries * sizeof(value_type));
+	}
+
 #pragma mark -
 #pragma mark SpanBase - Operators
 
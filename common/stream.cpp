@@ -261,6 +261,18 @@ bool SeekableSubReadStream::seek(int32 offset, int whence) {
 	return ret;
 }
 
+bool SeekableSubReadStream::getCursor(ByteCursor &cursor) const {
+	ByteCursor parent;
+	if (!_parentStream->getCursor(parent) || _end > parent.size())
+		return false;
+
+	// The position of the parent stream does not matter, which makes this
+	// work for SafeSeekableSubReadStream as well
+	cursor = ByteCursor(parent.getData() + _begin, _end - _begin);
+	cursor.seek(_pos - _begin);
+	return true;
+}
+
 uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Make sure the parent stream is at the right position
 	seek(0, SEEK_CUR);
@@ -29,6 +29,7 @@
 
 namespace Common {
 
+class ByteCursor;
 class SeekableReadStream;
 
 /**
@@ -443,6 +444,58 @@ public:
 		return f;
 	}
 
+	/**
+	 * Read count unsigned 16-bit words stored in little endian (LSB first)
+	 * order from the stream into dst, using a single read() call.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint16LEArray(uint16 *dst, uint32 count) {
+		const uint32 n = read(dst, count * 2) / 2;
+#ifdef SCUMM_BIG_ENDIAN
+		swapBytes16(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 32-bit words stored in little endian (LSB first)
+	 * order from the stream into dst, using a single read() call.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint32LEArray(uint32 *dst, uint32 count) {
+		const uint32 n = read(dst, count * 4) / 4;
+#ifdef SCUMM_BIG_ENDIAN
+		swapBytes32(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 16-bit words stored in big endian (MSB first)
+	 * order from the stream into dst, using a single read() call.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint16BEArray(uint16 *dst, uint32 count) {
+		const uint32 n = read(dst, count * 2) / 2;
+#ifdef SCUMM_LITTLE_ENDIAN
+		swapBytes16(dst, n);
+#endif
+		return n;
+	}
+
+	/**
+	 * Read count unsigned 32-bit words stored in big endian (MSB first)
+	 * order from the stream into dst, using a single read() call.
+	 * @return the number of words which were read completely
+	 */
+	uint32 readUint32BEArray(uint32 *dst, uint32 count) {
+		const uint32 n = read(dst, count * 4) / 4;
+#ifdef SCUMM_LITTLE_ENDIAN
+		swapBytes32(dst, n);
+#endif
+		return n;
+	}
+
 	/**
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which then is wrapped into a MemoryReadStream.
@@ -511,6 +564,19 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Get a cursor for reading the whole stream straight from memory, if
+	 * its content is available there, e.g. for a MemoryReadStream. The
+	 * cursor is positioned at the current position of the stream, and
+	 * stays valid as long as the stream exists.
+	 *
+	 * Reading through the cursor does not change the position of the
+	 * stream; use seek(cursor.pos()) to sync it afterwards.
+	 *
+	 * @return true on success, false if the stream is not memory based
+	 */
+	virtual bool getCursor(ByteCursor &cursor) const { return false; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
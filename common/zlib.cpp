@@ -25,6 +25,7 @@
 
 #include "common/zlib.h"
 #include "common/ptr.h"
+#include "common/savecontainer.h"
 #include "common/util.h"
 #include "common/stream.h"
 #include "common/debug.h"
@@ -51,6 +52,10 @@ bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long
 	return Z_OK == ::uncompress(dst, dstLen, src, srcLen);
 }
 
+bool compress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen, int level) {
+	return Z_OK == ::compress2(dst, dstLen, src, srcLen, level);
+}
+
 bool inflateZlibHeaderless(byte *dst, uint dstLen, const byte *src, uint srcLen, const byte *dict, uint dictLen) {
 	if (!dst || !dstLen || !src || !srcLen)
 		return false;
@@ -415,6 +420,9 @@ public:
 
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize) {
 	if (toBeWrapped) {
+		if (isSaveContainer(*toBeWrapped))
+			return new SaveContainerReadStream(toBeWrapped);
+
 		uint16 header = toBeWrapped->readUint16BE();
 		bool isCompressed = (header == 0x1F8B ||
 				     ((header & 0x0F00) == 0x0800 &&
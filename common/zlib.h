@@ -53,6 +53,25 @@ class WriteStream;
  */
 bool uncompress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen);
 
+/**
+ * Thin wrapper around zlib's compress2() function, the counterpart of
+ * uncompress().
+ *
+ * Compresses the src buffer into the dst buffer, using the zlib format.
+ * Upon entry, dstLen is the total size of the destination buffer. Upon
+ * exit, dstLen is the actual size of the compressed data.
+ *
+ * @param dst       the buffer to store into.
+ * @param dstLen    a pointer to the size of the destination buffer.
+ * @param src       the data to be compressed.
+ * @param srcLen    the size of the data.
+ * @param level     the compression level, between 0 and 9.
+ *
+ * @return true on success (i.e. Z_OK), false otherwise, in particular if the
+ *         compressed data does not fit into the destination buffer.
+ */
+bool compress(byte *dst, unsigned long *dstLen, const byte *src, unsigned long srcLen, int level);
+
 /**
  * Wrapper around zlib's inflate functions. This function will call the
  * necessary inflate functions to uncompress data compressed with deflate
@@ -107,6 +126,9 @@ bool inflateZlibInstallShield(byte *dst, uint dstLen, const byte *src, uint srcL
  * returned wrapped, unless there is no ZLIB support, then NULL is returned
  * and the old stream is destroyed.
  *
+ * Savefile containers (see SaveContainerWriteStream) are recognized as
+ * well, and returned wrapped in a SaveContainerReadStream.
+ *
  * Certain GZip-formats don't supply an easily readable length, if you
  * still need the length carried along with the stream, and you know
  * the decompressed length at wrap-time, then it can be supplied as knownSize
@@ -20,8 +20,10 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/util.h"
+#include "common/endian.h"
 #include "common/file.h"
 #include "common/macresman.h"
 #include "common/md5.h"
@@ -33,6 +35,142 @@
 #include "engines/advancedDetector.h"
 #include "engines/obsolete.h"
 
+namespace Common {
+DECLARE_SINGLETON(ADFilePropertiesCache);
+}
+
+enum {
+	kFilePropertiesCacheVersion = 2,
+	kFilePropertiesCacheMaxEntries = 5000
+};
+
+ADFilePropertiesCache::ADFilePropertiesCache() : _generation(0), _loaded(false), _dirty(false) {
+}
+
+ADFilePropertiesCache::~ADFilePropertiesCache() {
+	save();
+}
+
+static Common::String readString(Common::ReadStream &stream) {
+	Common::String str;
+	char c;
+	while ((c = stream.readByte()) != 0 && !stream.eos())
+		str += c;
+	return str;
+}
+
+void ADFilePropertiesCache::load() {
+	_loaded = true;
+
+	Common::FSNode configDir = Common::FSNode(g_system->getDefaultConfigFileName()).getParent();
+	if (!configDir.isDirectory())
+		return;
+
+	_file = configDir.getChild("detectcache.dat");
+	uint32 fileTime;
+	if (!_file.exists() || !_file.getModificationTime(fileTime))
+		return;
+
+	Common::SeekableReadStream *stream = _file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() == MKTAG('A', 'D', 'F', 'P') && stream->readUint32BE() == kFilePropertiesCacheVersion) {
+		_generation = stream->readUint32BE() + 1;
+		uint32 count = stream->readUint32BE();
+		for (uint32 i = 0; i < count && !stream->eos(); i++) {
+			Common::String key = readString(*stream);
+			Entry entry;
+			entry.time = stream->readUint32BE();
+			entry.generation = stream->readUint32BE();
+			entry.props.size = stream->readSint32BE();
+			entry.props.md5 = readString(*stream);
+
+			// Modification times only have a resolution of seconds, so a file
+			// modified in the second the cache was written may have changed
+			// after it was hashed
+			if (!stream->eos() && entry.time < fileTime)
+				_entries[key] = entry;
+		}
+	}
+
+	delete stream;
+}
+
+void ADFilePropertiesCache::save() {
+	if (!_dirty || !_file.getParent().isDirectory())
+		return;
+	_dirty = false;
+
+	Common::WriteStream *stream = _file.createWriteStream();
+	if (!stream)
+		return;
+
+	// Keep only the most recently used entries
+	Common::Array<EntryMap::const_iterator> entries;
+	entries.reserve(_entries.size());
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it)
+		entries.push_back(it);
+	Common::sort(entries.begin(), entries.end(), EntryGenerationGreater());
+	const uint count = MIN<uint>(entries.size(), kFilePropertiesCacheMaxEntries);
+
+	stream->writeUint32BE(MKTAG('A', 'D', 'F', 'P'));
+	stream->writeUint32BE(kFilePropertiesCacheVersion);
+	stream->writeUint32BE(_generation);
+	stream->writeUint32BE(count);
+	for (uint i = 0; i < count; i++) {
+		EntryMap::const_iterator it = entries[i];
+		stream->writeString(it->_key);
+		stream->writeByte(0);
+		stream->writeUint32BE(it->_value.time);
+		stream->writeUint32BE(it->_value.generation);
+		stream->writeSint32BE(it->_value.props.size);
+		stream->writeString(it->_value.props.md5);
+		stream->writeByte(0);
+	}
+
+	stream->finalize();
+	delete stream;
+}
+
+bool ADFilePropertiesCache::getFileProperties(const Common::FSNode &node, uint md5Bytes, ADFileProperties &fileProps) {
+	if (!_loaded)
+		load();
+
+	// Files whose modification time or size is unknown cannot be cached
+	uint32 time, size;
+	const bool cacheable = node.getModificationTime(time) && node.getFileSize(size);
+	const Common::String key = Common::String::format("%u:%s", md5Bytes, node.getPath().c_str());
+
+	if (cacheable) {
+		EntryMap::iterator it = _entries.find(key);
+		if (it != _entries.end() && it->_value.time == time && (uint32)it->_value.props.size == size) {
+			if (it->_value.generation != _generation) {
+				it->_value.generation = _generation;
+				_dirty = true;
+			}
+			fileProps = it->_value.props;
+			return true;
+		}
+	}
+
+	Common::File testFile;
+	if (!testFile.open(node))
+		return false;
+
+	fileProps.size = (int32)testFile.size();
+	fileProps.md5 = Common::computeStreamMD5AsString(testFile, md5Bytes);
+
+	if (cacheable) {
+		Entry &entry = _entries[key];
+		entry.time = time;
+		entry.generation = _generation;
+		entry.props = fileProps;
+		_dirty = true;
+	}
+	return true;
+}
+
 static GameDescriptor toGameDescriptor(const ADGameDescription &g, const PlainGameDescriptor *sg) {
 	const char *title = 0;
 	const char *extra;
@@ -418,14 +556,53 @@ bool AdvancedMetaEngine::getFileProperties(const Common::FSNode &parent, const F
 	if (!allFiles.contains(fname))
 		return false;
 
-	Common::File testFile;
+	return ADFilePropertiesCache::instance().getFileProperties(allFiles[fname], _md5Bytes, fileProps);
+}
 
-	if (!testFile.open(allFiles[fname]))
-		return false;
+void AdvancedMetaEngine::buildFileIndex() const {
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != 0; descPtr += _descItemSize) {
+		const ADGameDescription *g = (const ADGameDescription *)descPtr;
 
-	fileProps.size = (int32)testFile.size();
-	fileProps.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
-	return true;
+		if (!g->filesDescriptions[0].fileName)
+			_filelessDescs.push_back(g);
+
+		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+			ADGameDescList &descs = _fileIndex[fileDesc->fileName];
+			if (descs.empty() || descs.back() != g)
+				descs.push_back(g);
+		}
+	}
+
+	for (FileDescIndex::const_iterator it = _fileIndex.begin(); it != _fileIndex.end(); ++it) {
+		for (uint i = 0; i < it->_value.size(); i++) {
+			if (it->_value[i]->flags & ADGF_MACRESFORK) {
+				_macResForkFiles.push_back(it->_key);
+				break;
+			}
+		}
+	}
+
+	_fileIndexBuilt = true;
+}
+
+void AdvancedMetaEngine::addFileProperties(const Common::FSNode &parent, const FileMap &allFiles, const Common::String &fname, const ADGameDescList &descs, ADFilePropertiesMap &filesProps) const {
+	// Only the ADGF_MACRESFORK flag of the descriptor makes a difference, so
+	// there is no point in trying more than one descriptor of each kind.
+	bool triedPlain = false, triedResFork = false;
+
+	for (uint i = 0; i < descs.size(); i++) {
+		bool &tried = (descs[i]->flags & ADGF_MACRESFORK) ? triedResFork : triedPlain;
+		if (tried)
+			continue;
+		tried = true;
+
+		ADFileProperties tmp;
+		if (getFileProperties(parent, allFiles, *descs[i], fname, tmp)) {
+			debug(3, "> '%s': '%s'", fname.c_str(), tmp.md5.c_str());
+			filesProps[fname] = tmp;
+			return;
+		}
+	}
 }
 
 ADGameDescList AdvancedMetaEngine::detectGame(const Common::FSNode &parent, const FileMap &allFiles, Common::Language language, Common::Platform platform, const Common::String &extra) const {
@@ -433,28 +610,34 @@ ADGameDescList AdvancedMetaEngine::detectGame(const Common::FSNode &parent, cons
 
 	const ADGameFileDescription *fileDesc;
 	const ADGameDescription *g;
-	const byte *descPtr;
 
 	debug(3, "Starting detection in dir '%s'", parent.getPath().c_str());
 
+	if (!_fileIndexBuilt)
+		buildFileIndex();
+
 	// Check which files are included in some ADGameDescription *and* are present.
 	// Compute MD5s and file sizes for these files.
-	for (descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != 0; descPtr += _descItemSize) {
-		g = (const ADGameDescription *)descPtr;
-
-		for (fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
-			Common::String fname = fileDesc->fileName;
-			ADFileProperties tmp;
-
-			if (filesProps.contains(fname))
-				continue;
+	for (FileMap::const_iterator file = allFiles.begin(); file != allFiles.end(); ++file) {
+		FileDescIndex::const_iterator it = _fileIndex.find(file->_key);
+		if (it != _fileIndex.end())
+			addFileProperties(parent, allFiles, it->_key, it->_value, filesProps);
+	}
+	for (uint i = 0; i < _macResForkFiles.size(); i++) {
+		const Common::String &fname = _macResForkFiles[i];
+		if (!filesProps.contains(fname))
+			addFileProperties(parent, allFiles, fname, _fileIndex[fname], filesProps);
+	}
 
-			if (getFileProperties(parent, allFiles, *g, fname, tmp)) {
-				debug(3, "> '%s': '%s'", fname.c_str(), tmp.md5.c_str());
-				filesProps[fname] = tmp;
-			}
-		}
+	// Only descriptors referencing at least one of these files can match,
+	// so collect those, in their original order.
+	ADGameDescList candidates(_filelessDescs);
+	for (ADFilePropertiesMap::const_iterator file = filesProps.begin(); file != filesProps.end(); ++file) {
+		const ADGameDescList &descs = _fileIndex[file->_key];
+		for (uint i = 0; i < descs.size(); i++)
+			candidates.push_back(descs[i]);
 	}
+	Common::sort(candidates.begin(), candidates.end());
 
 	ADGameDescList matched;
 	ADGameIdList matchedGameIds;
@@ -462,9 +645,12 @@ ADGameDescList AdvancedMetaEngine::detectGame(const Common::FSNode &parent, cons
 	bool gotAnyMatchesWithAllFiles = false;
 
 	// MD5 based matching
-	uint i;
-	for (i = 0, descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != 0; descPtr += _descItemSize, ++i) {
-		g = (const ADGameDescription *)descPtr;
+	for (uint c = 0; c < candidates.size(); c++) {
+		g = candidates[c];
+		if (c > 0 && g == candidates[c - 1])
+			continue;
+
+		const uint i = ((const byte *)g - _gameDescriptors) / _descItemSize;
 		bool fileMissing = false;
 
 		// Do not even bother to look at entries which do not have matching
@@ -649,6 +835,7 @@ AdvancedMetaEngine::AdvancedMetaEngine(const void *descs, uint descItemSize, con
 	_maxScanDepth = 1;
 	_directoryGlobs = NULL;
 	_matchFullPaths = false;
+	_fileIndexBuilt = false;
 }
 
 void AdvancedMetaEngine::initSubSystems(const ADGameDescription *gameDesc) const {
@@ -27,6 +27,7 @@
 #include "engines/engine.h"
 
 #include "common/hash-str.h"
+#include "common/singleton.h"
 
 #include "common/gui_options.h" // FIXME: Temporary hack?
 
@@ -61,6 +62,57 @@ struct ADFileProperties {
  */
 typedef Common::HashMap<Common::String, ADFileProperties, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> ADFilePropertiesMap;
 
+/**
+ * Cache of the properties of files looked at during detection, shared by all
+ * AdvancedMetaEngines. Many engines check files with the same names, and
+ * detecting the same directories again is common, so this saves reading the
+ * same files over and over.
+ *
+ * Entries are keyed by path and by the number of bytes hashed, and are only
+ * used as long as the modification time and the size of the file are the
+ * same. They are kept in a file in the config directory, which is written
+ * when the cache is destroyed. Only the most recently used entries are kept
+ * in that file, so that it does not grow without bounds.
+ */
+class ADFilePropertiesCache : public Common::Singleton<ADFilePropertiesCache> {
+public:
+	ADFilePropertiesCache();
+	~ADFilePropertiesCache();
+
+	/**
+	 * Get the properties of the given file, with the MD5 computed over its
+	 * first md5Bytes bytes, or all of it if md5Bytes is 0.
+	 *
+	 * @return false if the file cannot be opened
+	 */
+	bool getFileProperties(const Common::FSNode &node, uint md5Bytes, ADFileProperties &fileProps);
+
+	/** Write the cache to the config directory, if it changed. */
+	void save();
+
+private:
+	struct Entry {
+		uint32 time;
+		uint32 generation; ///< The last run in which the entry was used
+		ADFileProperties props;
+	};
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	struct EntryGenerationGreater {
+		bool operator()(const EntryMap::const_iterator &a, const EntryMap::const_iterator &b) const {
+			return a->_value.generation > b->_value.generation;
+		}
+	};
+
+	EntryMap _entries;
+	Common::FSNode _file;
+	uint32 _generation; ///< Counts the runs which used the cache
+	bool _loaded;
+	bool _dirty;
+
+	void load();
+};
+
 /**
  * A shortcut to produce an empty ADGameFileDescription record. Used to mark
  * the end of a list of these.
@@ -301,6 +353,19 @@ protected:
 private:
 	void initSubSystems(const ADGameDescription *gameDesc) const;
 
+	typedef Common::HashMap<Common::String, ADGameDescList, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FileDescIndex;
+
+	/** The descriptors referencing each file name, built on first use. */
+	mutable FileDescIndex _fileIndex;
+	/** Names of files referenced by ADGF_MACRESFORK descriptors, which need not be in allFiles. */
+	mutable Common::Array<Common::String> _macResForkFiles;
+	/** Descriptors without any files. */
+	mutable ADGameDescList _filelessDescs;
+	mutable bool _fileIndexBuilt;
+
+	void buildFileIndex() const;
+	void addFileProperties(const Common::FSNode &parent, const FileMap &allFiles, const Common::String &fname, const ADGameDescList &descs, ADFilePropertiesMap &filesProps) const;
+
 protected:
 	/**
 	 * Detect games in specified directory.
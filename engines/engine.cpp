@@ -32,11 +32,13 @@
 
 #include "engines/engine.h"
 #include "engines/dialogs.h"
+#include "engines/savewriter.h"
 #include "engines/util.h"
 
 #include "common/config-manager.h"
 #include "common/events.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/system.h"
 #include "common/str.h"
 #include "common/error.h"
@@ -149,6 +151,7 @@ Engine::Engine(OSystem *syst)
 		_pauseStartTime(0),
 		_saveSlotToLoad(-1),
 		_engineStartTime(_system->getMillis()),
+		_saveWriter(NULL),
 		_mainMenuDialog(NULL) {
 
 	g_engine = this;
@@ -183,6 +186,9 @@ Engine::Engine(OSystem *syst)
 Engine::~Engine() {
 	_mixer->stopAll();
 
+	// Wait for the pending background saves
+	delete _saveWriter;
+
 	delete _mainMenuDialog;
 	g_engine = NULL;
 
@@ -192,7 +198,23 @@ Engine::~Engine() {
 }
 
 void Engine::initializePath(const Common::FSNode &gamePath) {
-	SearchMan.addDirectory(gamePath.getPath(), gamePath, 0, 4);
+	if (!ConfMan.getBool("fs_index")) {
+		SearchMan.addDirectory(gamePath.getPath(), gamePath, 0, 4);
+		return;
+	}
+
+	if (!gamePath.exists() || !gamePath.isDirectory())
+		return;
+
+	Common::FSDirectory *dir = new Common::FSDirectory(gamePath, 4);
+
+	// The index file is named after the game path, so that every game
+	// directory gets its own
+	Common::FSNode configDir = Common::FSNode(_system->getDefaultConfigFileName()).getParent();
+	if (configDir.isDirectory())
+		dir->setIndexFile(configDir.getChild(Common::String::format("fsindex-%08x.dat", Common::hashit(gamePath.getPath()))));
+
+	SearchMan.add(gamePath.getPath(), dir, 0);
 }
 
 void initCommonGFX() {
@@ -463,6 +485,24 @@ bool Engine::shouldPerformAutoSave(int lastSaveTime) {
 	return autosavePeriod != 0 && diff > autosavePeriod * 1000;
 }
 
+bool Engine::saveInBackground(const Common::String &filename, byte *data, uint32 size, uint32 metadataSize) {
+	if (!_saveWriter)
+		_saveWriter = new BackgroundSaveWriter(_saveFileMan, _timer);
+	return _saveWriter->queue(filename, data, size, metadataSize);
+}
+
+Common::Error Engine::waitForBackgroundSaves() {
+	if (!_saveWriter)
+		return Common::kNoError;
+	return _saveWriter->wait();
+}
+
+Common::Error Engine::checkBackgroundSaves() {
+	if (!_saveWriter)
+		return Common::kNoError;
+	return _saveWriter->check();
+}
+
 void Engine::errorString(const char *buf1, char *buf2, int size) {
 	Common::strlcpy(buf2, buf1, size);
 }
@@ -503,6 +543,7 @@ void Engine::openMainMenuDialog() {
 	// mouse cursor glitches and simliar bugs,
 	// e.g. #2822778).
 	if (_saveSlotToLoad >= 0) {
+		waitForBackgroundSaves();
 		Common::Error status = loadGameState(_saveSlotToLoad);
 		if (status.getCode() != Common::kNoError) {
 			Common::String failMessage = Common::String::format(_("Failed to load saved game (%s)! "
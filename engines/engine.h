@@ -31,6 +31,7 @@
 #include "common/singleton.h"
 
 class OSystem;
+class BackgroundSaveWriter;
 
 namespace Audio {
 class Mixer;
@@ -95,6 +96,12 @@ private:
 	 */
 	int _saveSlotToLoad;
 
+	/**
+	 * Writes the savefiles passed to saveInBackground(), created on first
+	 * use.
+	 */
+	BackgroundSaveWriter *_saveWriter;
+
 public:
 
 
@@ -149,7 +156,9 @@ public:
 	 * Init SearchMan according to the game path.
 	 *
 	 * By default it adds the directory in non-flat mode with a depth of 4 as
-	 * priority 0 to SearchMan.
+	 * priority 0 to SearchMan. If the "fs_index" setting is enabled, the
+	 * directory listings are kept in an index file in the config directory,
+	 * so that later runs only scan directories which have been modified.
 	 *
 	 * @param gamePath The base directory of the game data.
 	 */
@@ -322,6 +331,49 @@ public:
 	inline Common::EventManager *getEventManager() { return _eventMan; }
 	inline Common::SaveFileManager *getSaveFileManager() { return _saveFileMan; }
 
+	/**
+	 * Write a savefile in the background. This is meant for autosaves: the
+	 * engine only serializes its state into memory, and compressing and
+	 * writing the savefile does not stall the game.
+	 *
+	 * The savefile is stored in a savefile container (see
+	 * Common::SaveFileManager::openContainerForSaving()), with the first
+	 * metadataSize bytes of data as its uncompressed metadata.
+	 *
+	 * Savefiles being written in the background must not be loaded before
+	 * waitForBackgroundSaves() has been called. Engine does so itself before
+	 * loading from the global main menu.
+	 *
+	 * @param filename		the name of the savefile
+	 * @param data			the content of the savefile, allocated with
+	 *						malloc(), e.g. by a MemoryWriteStreamDynamic
+	 *						which does not dispose of its memory. It is freed
+	 *						once the savefile has been written.
+	 * @param size			the size of data
+	 * @param metadataSize	the size of the savegame header and thumbnail at
+	 *						the start of data
+	 * @return false if the savefile could not be opened
+	 */
+	bool saveInBackground(const Common::String &filename, byte *data, uint32 size, uint32 metadataSize = 0);
+
+	/**
+	 * Wait until all savefiles passed to saveInBackground() are written.
+	 *
+	 * @return the first error which occurred while writing them in the
+	 *         background since the last call to this method or to
+	 *         checkBackgroundSaves()
+	 */
+	Common::Error waitForBackgroundSaves();
+
+	/**
+	 * Check whether writing a savefile in the background failed.
+	 *
+	 * @return the first error which occurred while writing savefiles in the
+	 *         background since the last call to this method or to
+	 *         waitForBackgroundSaves()
+	 */
+	Common::Error checkBackgroundSaves();
+
 public:
 
 	/** On some systems, check if the game appears to be run from CD. */
@@ -6,7 +6,8 @@ MODULE_OBJS := \
 	engine.o \
 	game.o \
 	obsolete.o \
-	savestate.o
+	savestate.o \
+	savewriter.o
 
 # Include common rules
 include $(srcdir)/rules.mk
@@ -0,0 +1,203 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/savewriter.h"
+
+#include "common/savecontainer.h"
+#include "common/savefile.h"
+#include "common/textconsole.h"
+#include "common/timer.h"
+#include "common/util.h"
+
+/**
+ * Forwards everything to a savefile, except for finalize(), which only
+ * flushes it: savefiles are finalized on the engine thread.
+ */
+class SaveFileForwarder : public Common::WriteStream {
+	Common::OutSaveFile *_file;
+
+public:
+	SaveFileForwarder(Common::OutSaveFile *file) : _file(file) {}
+
+	virtual bool err() const { return _file->err(); }
+	virtual void clearErr() { _file->clearErr(); }
+	virtual void finalize() { _file->flush(); }
+	virtual bool flush() { return _file->flush(); }
+	virtual uint32 write(const void *dataPtr, uint32 dataSize) { return _file->write(dataPtr, dataSize); }
+	virtual int32 pos() const { return _file->pos(); }
+};
+
+BackgroundSaveWriter::BackgroundSaveWriter(Common::SaveFileManager *saveFileMan, Common::TimerManager *timer)
+	: _saveFileMan(saveFileMan), _timer(timer), _error(Common::kNoError) {
+	_timerInstalled = _timer->installTimerProc(&timerProc, kTimerInterval, this, "BackgroundSaveWriter");
+	if (!_timerInstalled)
+		warning("Failed to install the background savefile writer's timer, savefiles are written right away");
+}
+
+BackgroundSaveWriter::~BackgroundSaveWriter() {
+	if (_timerInstalled)
+		_timer->removeTimerProc(&timerProc);
+	wait();
+}
+
+void BackgroundSaveWriter::timerProc(void *refCon) {
+	BackgroundSaveWriter *writer = (BackgroundSaveWriter *)refCon;
+	Common::StackLock lock(writer->_mutex);
+	writer->writeSlice();
+}
+
+bool BackgroundSaveWriter::writeSlice() {
+	for (uint i = 0; i < _jobs.size(); ++i) {
+		Job &job = *_jobs[i];
+		if (job._done)
+			continue;
+
+		const uint32 n = MIN<uint32>(kSliceSize, job._size - job._written);
+		job._container->write(job._data + job._written, n);
+		job._written += n;
+
+		if (job._written == job._size || job._container->err()) {
+			job._container->finalize();
+			job._done = true;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void BackgroundSaveWriter::closeFinished() {
+	Common::Array<Job *> finished;
+	{
+		Common::StackLock lock(_mutex);
+		for (uint i = 0; i < _jobs.size(); ) {
+			if (_jobs[i]->_done) {
+				finished.push_back(_jobs[i]);
+				_jobs.remove_at(i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	for (uint i = 0; i < finished.size(); ++i) {
+		Job *job = finished[i];
+		bool failed = job->_container->err();
+		delete job->_container;
+
+		// The temporary savefile has to be closed before it can be renamed,
+		// so it is only flushed here instead of being finalized
+		job->_file->flush();
+		failed = failed || job->_file->err();
+		delete job->_file;
+		free(job->_data);
+
+		// Only replace the savefile once the new one is complete, so that a
+		// crash while writing does not lose both of them
+		if (failed || (job->_tempName != job->_filename && !_saveFileMan->renameSavefile(job->_tempName, job->_filename))) {
+			// Do not leave a broken savefile behind
+			_saveFileMan->removeSavefile(job->_tempName);
+			if (_error.getCode() == Common::kNoError)
+				_error = Common::Error(Common::kWritingFailed, job->_filename);
+		}
+		delete job;
+	}
+}
+
+bool BackgroundSaveWriter::queue(const Common::String &filename, byte *data, uint32 size, uint32 metadataSize) {
+	assert(metadataSize <= size);
+
+	// Earlier versions of the same savefile have to be written first,
+	// and only a limited amount of savefiles are kept in memory
+	for (;;) {
+		Common::StackLock lock(_mutex);
+		uint pending = 0;
+		bool sameFile = false;
+		for (uint i = 0; i < _jobs.size(); ++i) {
+			if (!_jobs[i]->_done) {
+				++pending;
+				sameFile = sameFile || _jobs[i]->_filename.equalsIgnoreCase(filename);
+			}
+		}
+
+		if (!sameFile && pending < kMaxQueuedFiles)
+			break;
+		writeSlice();
+	}
+	closeFinished();
+
+	// The savefile is written under a temporary name first, and renamed
+	// once it is complete. Where renaming means copying, the copy would
+	// be made on the engine thread and unpack the savefile, so it is
+	// written to its real name right away instead.
+	const Common::String tempName = _saveFileMan->canRenameSavefiles() ? "~" + filename : filename;
+	Common::OutSaveFile *file = _saveFileMan->openForSaving(tempName, false);
+	if (!file) {
+		free(data);
+		return false;
+	}
+
+	Job *job = new Job;
+	job->_filename = filename;
+	job->_tempName = tempName;
+	job->_data = data;
+	job->_size = size;
+	job->_file = file;
+	job->_container = new Common::SaveContainerWriteStream(new SaveFileForwarder(file), Common::kSaveCompressionFast);
+	job->_done = false;
+
+	// The metadata is stored uncompressed, so it is written right away
+	job->_container->write(data, metadataSize);
+	job->_container->endMetadata();
+	job->_written = metadataSize;
+
+	{
+		Common::StackLock lock(_mutex);
+		_jobs.push_back(job);
+	}
+	if (!_timerInstalled)
+		writeAll();
+	return true;
+}
+
+void BackgroundSaveWriter::writeAll() {
+	// The lock is released after every slice, so that the timer thread,
+	// which also runs the other timers, is never blocked for long
+	for (;;) {
+		Common::StackLock lock(_mutex);
+		if (!writeSlice())
+			break;
+	}
+}
+
+Common::Error BackgroundSaveWriter::wait() {
+	writeAll();
+	return check();
+}
+
+Common::Error BackgroundSaveWriter::check() {
+	closeFinished();
+
+	const Common::Error error = _error;
+	_error = Common::Error(Common::kNoError);
+	return error;
+}
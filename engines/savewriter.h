@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef ENGINES_SAVEWRITER_H
+#define ENGINES_SAVEWRITER_H
+
+#include "common/array.h"
+#include "common/error.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Common {
+class OutSaveFile;
+class SaveContainerWriteStream;
+class SaveFileManager;
+class TimerManager;
+}
+
+/**
+ * Writes savefiles from a timer, so that compressing and writing them does
+ * not stall the engine. See Engine::saveInBackground().
+ *
+ * The savefiles are opened and closed on the engine thread, as the
+ * SaveFileManager is not thread safe. In between, a timer compresses and
+ * writes one block of each savefile per tick, which keeps the other timers,
+ * like music drivers, running smoothly. If the SaveFileManager can rename
+ * savefiles cheaply, each savefile is written under a temporary name, and
+ * only renamed once it is complete, so that the previous version survives a
+ * crash while writing.
+ */
+class BackgroundSaveWriter {
+public:
+	BackgroundSaveWriter(Common::SaveFileManager *saveFileMan, Common::TimerManager *timer);
+	~BackgroundSaveWriter();
+
+	/**
+	 * Queue a savefile for writing. If too many savefiles are queued
+	 * already, the oldest one is written right away.
+	 *
+	 * @param filename		the name of the savefile, which is replaced only
+	 *						once the new savefile has been written completely,
+	 *						if the SaveFileManager can rename savefiles
+	 * @param data			the content of the savefile, allocated with
+	 *						malloc(), and freed once written
+	 * @param size			the size of data
+	 * @param metadataSize	the size of the metadata at the start of data,
+	 *						see SaveFileManager::openContainerForSaving()
+	 * @return false if the savefile could not be opened
+	 */
+	bool queue(const Common::String &filename, byte *data, uint32 size, uint32 metadataSize);
+
+	/**
+	 * Write all queued savefiles right away.
+	 *
+	 * @return the first error which occurred since the last call to wait()
+	 *         or check()
+	 */
+	Common::Error wait();
+
+	/**
+	 * Close the savefiles written so far.
+	 *
+	 * @return the first error which occurred since the last call to wait()
+	 *         or check()
+	 */
+	Common::Error check();
+
+private:
+	enum {
+		kMaxQueuedFiles = 2,
+		kTimerInterval = 10000,
+		kSliceSize = 65536
+	};
+
+	struct Job {
+		Common::String _filename;
+		Common::String _tempName;	///< The name the savefile is written to, may be _filename
+		byte *_data;
+		uint32 _size;
+		uint32 _written;
+		Common::OutSaveFile *_file;
+		Common::SaveContainerWriteStream *_container;
+		bool _done;
+	};
+
+	static void timerProc(void *refCon);
+
+	/** Write the next slice of the oldest unfinished job. Needs _mutex. */
+	bool writeSlice();
+	/** Write all unfinished jobs, taking _mutex for each slice. */
+	void writeAll();
+	/** Close the finished jobs, and move them to their final names. */
+	void closeFinished();
+
+	Common::SaveFileManager *_saveFileMan;
+	Common::TimerManager *_timer;
+	bool _timerInstalled;
+	Common::Mutex _mutex;
+	Common::Array<Job *> _jobs;
+	Common::Error _error;
+};
+
+#endif
@@ -59,6 +59,7 @@ namespace Wintermute {
 BasePersistenceManager::BasePersistenceManager(const Common::String &savePrefix, bool deleteSingleton) {
 	_saving = false;
 	_offset = 0;
+	_headerSize = 0;
 	_saveStream = nullptr;
 	_loadStream = nullptr;
 	_deleteSingleton = deleteSingleton;
@@ -112,6 +113,7 @@ BasePersistenceManager::~BasePersistenceManager() {
 //////////////////////////////////////////////////////////////////////////
 void BasePersistenceManager::cleanup() {
 	_offset = 0;
+	_headerSize = 0;
 
 	delete[] _richBuffer;
 	_richBuffer = nullptr;
@@ -307,6 +309,8 @@ bool BasePersistenceManager::initSave(const Common::String &desc) {
 		putTimeDate(_savedTimestamp);
 		_savedPlayTime = g_system->getMillis();
 		_saveStream->writeUint32LE(_savedPlayTime);
+
+		_headerSize = _saveStream->pos();
 	}
 	return STATUS_OK;
 }
@@ -423,9 +427,16 @@ bool BasePersistenceManager::saveFile(const Common::String &filename) {
 	uint32 bufferSize = ((Common::MemoryWriteStreamDynamic *)_saveStream)->size();
 
 	Common::SaveFileManager *saveMan = ((WintermuteEngine *)g_engine)->getSaveFileMan();
-	Common::OutSaveFile *file = saveMan->openForSaving(filename);
+	// The header and thumbnails are kept uncompressed, so that listing the
+	// savegames does not need to decompress the whole game state
+	Common::OutSaveFile *file = saveMan->openContainerForSaving(filename);
+	if (!file) {
+		return STATUS_FAILED;
+	}
 	file->write(prefixBuffer, prefixSize);
-	file->write(buffer, bufferSize);
+	file->write(buffer, _headerSize);
+	file->endMetadata();
+	file->write(buffer + _headerSize, bufferSize - _headerSize);
 	bool retVal = !file->err();
 	file->finalize();
 	delete file;
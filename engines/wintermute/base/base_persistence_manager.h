@@ -102,6 +102,7 @@ private:
 	bool putTimeDate(const TimeDate &t);
 	Common::WriteStream *_saveStream;
 	Common::SeekableReadStream *_loadStream;
+	uint32 _headerSize;	///< Size of the savegame header written by initSave()
 	TimeDate _savedTimestamp;
 	uint32 _savedPlayTime;
 	byte _savedVerMajor;
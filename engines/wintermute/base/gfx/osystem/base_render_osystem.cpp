@@ -40,6 +40,7 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+#define TRANSFORM_CACHE_SIZE (16 * 1024 * 1024)
 
 namespace Wintermute {
 
@@ -48,7 +49,7 @@ BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
+BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame), _transformCache(TRANSFORM_CACHE_SIZE) {
 	_renderSurface = new Graphics::Surface();
 	_blankSurface = new Graphics::Surface();
 	_lastFrameIter = _renderQueue.end();
@@ -320,6 +321,8 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	_transformCache.invalidate(surf);
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
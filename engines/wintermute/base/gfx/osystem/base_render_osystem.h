@@ -33,6 +33,7 @@
 #include "common/rect.h"
 #include "graphics/surface.h"
 #include "common/list.h"
+#include "graphics/transform_cache.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
@@ -80,6 +81,7 @@ public:
 
 	void invalidateTicket(RenderTicket *renderTicket);
 	void invalidateTicketsFromSurface(BaseSurfaceOSystem *surf);
+	Graphics::TransformCache &getTransformCache() { return _transformCache; }
 	/**
 	 * Insert a new ticket into the queue, adding a dirty rect
 	 * @param renderTicket the ticket to be added.
@@ -140,6 +142,8 @@ private:
 	int _borderRight;
 	int _borderBottom;
 
+	Graphics::TransformCache _transformCache;
+
 	bool _disableDirtyRects;
 	float _ratioX;
 	float _ratioY;
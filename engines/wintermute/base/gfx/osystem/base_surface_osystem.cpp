@@ -186,6 +186,10 @@ bool BaseSurfaceOSystem::finishLoad() {
 
 	delete image;
 
+	// The pixels may have changed since the surface was last loaded
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
+	renderer->invalidateTicketsFromSurface(this);
+
 	_loaded = true;
 
 	return true;
@@ -30,6 +30,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "graphics/transform_tools.h"
 #include "common/textconsole.h"
 
@@ -43,14 +44,7 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_wantsDraw(true),
 	_transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
-		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
-		}
-		// Then scale it if necessary
+		// Scale or rotate it if necessary
 		//
 		// NB: The numTimesX/numTimesY properties don't yet mix well with
 		// scaling and rotation, but there is no need for that functionality at
@@ -58,30 +52,28 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
+		//
+		// The transformed surfaces are shared through the renderer's cache,
+		// so that a sprite drawn with the same transform every frame is only
+		// transformed once.
 		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
-			} else {
-				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
-			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(owner->_gameRef->_renderer);
+			_transformedSurface = renderer->getTransformCache().rotoscale(owner, *surf, *srcRect, transform, getFilteringMode(owner));
+			_surface = _transformedSurface.get();
 		} else if ((dstRect->width() != srcRect->width() ||
 					dstRect->height() != srcRect->height()) &&
 					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect->width(), dstRect->height());
-			} else {
-				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
+			BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(owner->_gameRef->_renderer);
+			_transformedSurface = renderer->getTransformCache().scale(owner, *surf, *srcRect, dstRect->width(), dstRect->height(), getFilteringMode(owner));
+			_surface = _transformedSurface.get();
+		} else {
+			_surface = new Graphics::Surface();
+			_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+			assert(_surface->format.bytesPerPixel == 4);
+			// Get a clipped copy of the surface
+			for (int i = 0; i < _surface->h; i++) {
+				memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
 		}
 	} else {
 		_surface = nullptr;
@@ -89,12 +81,21 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
+	// Transformed surfaces are owned by the transform cache
+	if (_surface && !_transformedSurface) {
 		_surface->free();
 		delete _surface;
 	}
 }
 
+Graphics::TFilteringMode RenderTicket::getFilteringMode(BaseSurfaceOSystem *owner) {
+	if (owner->_gameRef->getBilinearFiltering()) {
+		return Graphics::FILTER_BILINEAR;
+	} else {
+		return Graphics::FILTER_NEAREST;
+	}
+}
+
 bool RenderTicket::operator==(const RenderTicket &t) const {
 	if ((t._owner != _owner) ||
 		(t._transform != _transform)  ||
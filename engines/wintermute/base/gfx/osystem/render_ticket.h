@@ -31,6 +31,7 @@
 
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 
 namespace Wintermute {
@@ -71,7 +72,10 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
+	static Graphics::TFilteringMode getFilteringMode(BaseSurfaceOSystem *owner);
+
 	Graphics::Surface *_surface;
+	Common::SharedPtr<Graphics::Surface> _transformedSurface;
 	Common::Rect _srcRect;
 };
 
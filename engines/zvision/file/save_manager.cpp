@@ -81,6 +81,8 @@ void SaveManager::saveGame(uint slot, const Common::String &saveName, bool useSa
 	if (!_tempSave && useSaveBuffer)
 		return;
 
+	_engine->waitForBackgroundSaves();
+
 	Common::SaveFileManager *saveFileManager = g_system->getSavefileManager();
 	Common::OutSaveFile *file = saveFileManager->openForSaving(_engine->generateSaveFileName(slot));
 
@@ -101,10 +103,24 @@ void SaveManager::saveGame(uint slot, const Common::String &saveName, bool useSa
 }
 
 void SaveManager::autoSave() {
-	saveGame(0, "Auto save", false);
+	Common::Error error = _engine->checkBackgroundSaves();
+	if (error.getCode() != Common::kNoError)
+		warning("Writing the last autosave failed: %s", error.getDesc().c_str());
+
+	// Only serialize the game here, and leave compressing and writing the
+	// savefile to the background, so that the game does not stall
+	Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::NO);
+	writeSaveGameHeader(&stream, "Auto save", false);
+	const uint32 headerSize = stream.size();
+	_engine->getScriptManager()->serialize(&stream);
+
+	if (!_engine->saveInBackground(_engine->generateSaveFileName(0), stream.getData(), stream.size(), headerSize))
+		warning("Could not open the autosave file for writing");
+
+	_lastSaveTime = g_system->getMillis();
 }
 
-void SaveManager::writeSaveGameHeader(Common::OutSaveFile *file, const Common::String &saveName, bool useSaveBuffer) {
+void SaveManager::writeSaveGameHeader(Common::WriteStream *file, const Common::String &saveName, bool useSaveBuffer) {
 	file->writeUint32BE(SAVEGAME_ID);
 
 	// Write version
@@ -134,6 +150,8 @@ Common::Error SaveManager::loadGame(int slot) {
 	Common::SeekableReadStream *saveFile = NULL;
 
 	if (slot >= 0) {
+		// The autosave may still be being written
+		_engine->waitForBackgroundSaves();
 		saveFile = getSlotFile(slot);
 	} else {
 		saveFile = _engine->getSearchManager()->openFile("r.svr");
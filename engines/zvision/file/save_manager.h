@@ -100,7 +100,7 @@ public:
 	void flushSaveBuffer();
 	bool scummVMSaveLoadDialog(bool isSave);
 private:
-	void writeSaveGameHeader(Common::OutSaveFile *file, const Common::String &saveName, bool useSaveBuffer);
+	void writeSaveGameHeader(Common::WriteStream *file, const Common::String &saveName, bool useSaveBuffer);
 };
 
 } // End of namespace ZVision
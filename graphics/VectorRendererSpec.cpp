@@ -536,7 +536,8 @@ VectorRendererSpec(PixelFormat format) :
 	_redMask((0xFF >> format.rLoss) << format.rShift),
 	_greenMask((0xFF >> format.gLoss) << format.gShift),
 	_blueMask((0xFF >> format.bLoss) << format.bShift),
-	_alphaMask((0xFF >> format.aLoss) << format.aShift) {
+	_alphaMask((0xFF >> format.aLoss) << format.aShift),
+	_gradLastStrip(0) {
 
 	_bitmapAlphaColor = _format.RGBToColor(255, 0, 255);
 	_clippingArea = Common::Rect(0, 0, 32767, 32767);
@@ -590,6 +591,7 @@ precalcGradient(int h) {
 
 	_gradCache.resize(0);
 	_gradIndexes.resize(0);
+	_gradLastStrip = 0;
 
 	for (int i = 0; i < h + 2; i++) {
 		color = calcGradient(i, h);
@@ -602,14 +604,25 @@ precalcGradient(int h) {
 }
 
 template<typename PixelType>
-void VectorRendererSpec<PixelType>::
-gradientFill(PixelType *ptr, int width, int x, int y) {
-	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
+int VectorRendererSpec<PixelType>::
+findGradientStrip(int y) {
+	// Rows are mostly filled in order, so continue from the strip of the
+	// previous row if possible
+	int curGrad = (_gradIndexes[_gradLastStrip] <= y) ? _gradLastStrip : 0;
 
 	while (_gradIndexes[curGrad + 1] <= y)
 		curGrad++;
 
+	_gradLastStrip = curGrad;
+	return curGrad;
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+gradientFill(PixelType *ptr, int width, int x, int y) {
+	bool ox = ((y & 1) == 1);
+	int curGrad = findGradientStrip(y);
+
 	// precalcGradient assures that _gradIndexes entries always differ in
 	// their value. This assures stripSize is always different from zero.
 	int stripSize = _gradIndexes[curGrad + 1] - _gradIndexes[curGrad];
@@ -647,10 +660,7 @@ void VectorRendererSpec<PixelType>::
 gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY) {
 	if (realY < _clippingArea.top || realY >= _clippingArea.bottom) return;
 	bool ox = ((y & 1) == 1);
-	int curGrad = 0;
-
-	while (_gradIndexes[curGrad + 1] <= y)
-		curGrad++;
+	int curGrad = findGradientStrip(y);
 
 	// precalcGradient assures that _gradIndexes entries always differ in
 	// their value. This assures stripSize is always different from zero.
@@ -1000,6 +1010,25 @@ applyScreenShading(GUI::ThemeEngine::ShadingStyle shadingStyle) {
 	}
 }
 
+template<typename PixelType>
+inline PixelType VectorRendererSpec<PixelType>::
+blendComponents32(PixelType dst, byte sR, byte sG, byte sB, uint8 alpha) {
+	byte dR = (dst & _redMask) >> _format.rShift;
+	byte dG = (dst & _greenMask) >> _format.gShift;
+	byte dB = (dst & _blueMask) >> _format.bShift;
+	byte dA = (dst & _alphaMask) >> _format.aShift;
+
+	dR += ((sR - dR) * alpha) >> 8;
+	dG += ((sG - dG) * alpha) >> 8;
+	dB += ((sB - dB) * alpha) >> 8;
+	dA += ((0xff - dA) * alpha) >> 8;
+
+	return ((dR << _format.rShift) & _redMask)
+	     | ((dG << _format.gShift) & _greenMask)
+	     | ((dB << _format.bShift) & _blueMask)
+	     | ((dA << _format.aShift) & _alphaMask);
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha) {
@@ -1011,20 +1040,7 @@ blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 		const byte sG = (color & _greenMask) >> _format.gShift;
 		const byte sB = (color & _blueMask) >> _format.bShift;
 
-		byte dR = (*ptr & _redMask) >> _format.rShift;
-		byte dG = (*ptr & _greenMask) >> _format.gShift;
-		byte dB = (*ptr & _blueMask) >> _format.bShift;
-		byte dA = (*ptr & _alphaMask) >> _format.aShift;
-
-		dR += ((sR - dR) * alpha) >> 8;
-		dG += ((sG - dG) * alpha) >> 8;
-		dB += ((sB - dB) * alpha) >> 8;
-		dA += ((0xff - dA) * alpha) >> 8;
-
-		*ptr = ((dR << _format.rShift) & _redMask)
-		     | ((dG << _format.gShift) & _greenMask)
-		     | ((dB << _format.bShift) & _blueMask)
-		     | ((dA << _format.aShift) & _alphaMask);
+		*ptr = blendComponents32(*ptr, sR, sG, sB, alpha);
 	} else if (sizeof(PixelType) == 2) {
 		int idst = *ptr;
 		int isrc = color;
@@ -1047,6 +1063,25 @@ blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	if (alpha == 0xff) {
+		// fully opaque pixels, don't blend
+		colorFill<PixelType>(first, last, color | _alphaMask);
+	} else if (sizeof(PixelType) == 4) {
+		const byte sR = (color & _redMask) >> _format.rShift;
+		const byte sG = (color & _greenMask) >> _format.gShift;
+		const byte sB = (color & _blueMask) >> _format.bShift;
+
+		for (; first != last; ++first)
+			*first = blendComponents32(*first, sR, sG, sB, alpha);
+	} else {
+		for (; first != last; ++first)
+			blendPixelPtr(first, color, alpha);
+	}
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 blendPixelPtrClip(PixelType *ptr, PixelType color, uint8 alpha, int x, int y) {
@@ -148,6 +148,17 @@ protected:
 	inline void blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha);
 	inline void blendPixelPtrClip(PixelType *ptr, PixelType color, uint8 alpha, int x, int y);
 
+	/**
+	 * Blends a 32bpp destination pixel with a color already split into
+	 * its components, and returns the result. Shared by blendPixelPtr()
+	 * and blendFill().
+	 *
+	 * @param dst The pixel to blend on top of
+	 * @param sR, sG, sB Components of the color to blend
+	 * @param alpha Alpha intensity of the color (0-255)
+	 */
+	inline PixelType blendComponents32(PixelType dst, byte sR, byte sG, byte sB, uint8 alpha);
+
 	/**
 	 * Blends a single pixel on the surface in the given pixel pointer, using supplied color
 	 * and Alpha intensity.
@@ -275,11 +286,14 @@ protected:
 	inline PixelType calcGradient(uint32 pos, uint32 max);
 
 	void precalcGradient(int h);
+	int findGradientStrip(int y);
 	void gradientFill(PixelType *first, int width, int x, int y);
 	void gradientFillClip(PixelType *first, int width, int x, int y, int realX, int realY);
 
 	/**
 	 * Fills several pixels in a row with a given color and the specified alpha blending.
+	 * Same as calling blendPixelPtr() on each of them, but the source color is only
+	 * split into its components once for the whole row.
 	 *
 	 * @see blendPixelPtr
 	 * @see blendPixel
@@ -288,19 +302,14 @@ protected:
 	 * @param color Color of the pixel
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
-	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
-		while (first != last) blendPixelPtr(first++, color, alpha);
-	}
+	void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha);
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
 		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first != last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
+			const int start = MAX<int>(_clippingArea.left - realX, 0);
+			const int end = MIN<int>(_clippingArea.right - realX, last - first);
+			if (start < end)
+				blendFill(first + start, first + end, color, alpha);
 		}
 	}
 
@@ -320,6 +329,7 @@ protected:
 
 	Common::Array<PixelType> _gradCache;
 	Common::Array<int> _gradIndexes;
+	int _gradLastStrip; /**< Strip of the gradient used by the last row filled */
 
 	PixelType _bevelColor;
 	PixelType _bitmapAlphaColor;
@@ -31,16 +31,76 @@ namespace Graphics {
 
 namespace {
 
-template<typename SrcColor, typename DstColor, bool backward>
+/**
+ * Converts colors between two formats only known at runtime.
+ */
+struct GenericColorConverter {
+	const PixelFormat _srcFmt;
+	const PixelFormat _dstFmt;
+
+	GenericColorConverter(const PixelFormat &srcFmt, const PixelFormat &dstFmt) : _srcFmt(srcFmt), _dstFmt(dstFmt) {}
+
+	inline uint32 operator()(uint32 color) const {
+		byte a, r, g, b;
+		_srcFmt.colorToARGB(color, a, r, g, b);
+		return _dstFmt.ARGBToColor(a, r, g, b);
+	}
+};
+
+/**
+ * A pixel format known at compile time, allowing the compiler to fold the
+ * shifts and masks of the conversion into constants.
+ */
+template<typename Color, int aBits, int rBits, int gBits, int bBits, int aShift, int rShift, int gShift, int bShift>
+struct StaticFormat {
+	typedef Color ColorType;
+
+	static PixelFormat get() {
+		return PixelFormat(sizeof(Color), rBits, gBits, bBits, aBits, rShift, gShift, bShift, aShift);
+	}
+
+	static inline void colorToARGB(uint32 color, byte &a, byte &r, byte &g, byte &b) {
+		a = (aBits == 0) ? 0xFF : ColorComponent<aBits>::expand(color >> aShift);
+		r = ColorComponent<rBits>::expand(color >> rShift);
+		g = ColorComponent<gBits>::expand(color >> gShift);
+		b = ColorComponent<bBits>::expand(color >> bShift);
+	}
+
+	static inline uint32 ARGBToColor(byte a, byte r, byte g, byte b) {
+		return
+			((a >> (8 - aBits)) << aShift) |
+			((r >> (8 - rBits)) << rShift) |
+			((g >> (8 - gBits)) << gShift) |
+			((b >> (8 - bBits)) << bShift);
+	}
+};
+
+typedef StaticFormat<uint16, 0, 5, 6, 5,  0, 11,  5,  0> FormatRGB565;
+typedef StaticFormat<uint16, 0, 5, 5, 5,  0, 10,  5,  0> FormatRGB555;
+typedef StaticFormat<uint32, 8, 8, 8, 8,  0, 24, 16,  8> FormatRGBA8888;
+typedef StaticFormat<uint32, 8, 8, 8, 8, 24, 16,  8,  0> FormatARGB8888;
+typedef StaticFormat<uint32, 8, 8, 8, 8, 24,  0,  8, 16> FormatABGR8888;
+typedef StaticFormat<uint32, 8, 8, 8, 8,  0,  8, 16, 24> FormatBGRA8888;
+
+/**
+ * Converts colors between two formats known at compile time.
+ */
+template<typename SrcFormat, typename DstFormat>
+struct StaticColorConverter {
+	inline uint32 operator()(uint32 color) const {
+		byte a, r, g, b;
+		SrcFormat::colorToARGB(color, a, r, g, b);
+		return DstFormat::ARGBToColor(a, r, g, b);
+	}
+};
+
+template<typename SrcColor, typename DstColor, bool backward, typename Converter>
 inline void crossBlitLogic(byte *dst, const byte *src, const uint w, const uint h,
-                           const PixelFormat &srcFmt, const PixelFormat &dstFmt,
+                           const Converter &convert,
                            const uint srcDelta, const uint dstDelta) {
 	for (uint y = 0; y < h; ++y) {
 		for (uint x = 0; x < w; ++x) {
-			const uint32 color = *(const SrcColor *)src;
-			byte a, r, g, b;
-			srcFmt.colorToARGB(color, a, r, g, b);
-			*(DstColor *)dst = dstFmt.ARGBToColor(a, r, g, b);
+			*(DstColor *)dst = convert(*(const SrcColor *)src);
 
 			if (backward) {
 				src -= sizeof(SrcColor);
@@ -96,6 +156,96 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+/**
+ * Blit between the given formats. The pointers must already point to the
+ * last pixel of the area for backward blits.
+ */
+template<typename SrcColor, typename DstColor, bool backward, typename Converter>
+void crossBlitStatic(byte *dst, const byte *src, const uint w, const uint h,
+                     const uint srcDelta, const uint dstDelta) {
+	crossBlitLogic<SrcColor, DstColor, backward>(dst, src, w, h, Converter(), srcDelta, dstDelta);
+}
+
+typedef void (*CrossBlitFunc)(byte *dst, const byte *src, const uint w, const uint h,
+                              const uint srcDelta, const uint dstDelta);
+
+struct StaticCrossBlit {
+	PixelFormat srcFmt;
+	PixelFormat dstFmt;
+	CrossBlitFunc func;
+};
+
+template<typename SrcFormat, typename DstFormat>
+StaticCrossBlit makeStaticCrossBlit() {
+	typedef typename SrcFormat::ColorType SrcColor;
+	typedef typename DstFormat::ColorType DstColor;
+	// See crossBlit() for why widening conversions are done backwards
+	const bool backward = sizeof(DstColor) > sizeof(SrcColor);
+
+	StaticCrossBlit entry;
+	entry.srcFmt = SrcFormat::get();
+	entry.dstFmt = DstFormat::get();
+	entry.func = &crossBlitStatic<SrcColor, DstColor, backward, StaticColorConverter<SrcFormat, DstFormat> >;
+	return entry;
+}
+
+/**
+ * Specialized conversions between the formats commonly used by engines
+ * and backends.
+ */
+const StaticCrossBlit *getStaticCrossBlits(uint &count) {
+	static const StaticCrossBlit staticCrossBlits[] = {
+		makeStaticCrossBlit<FormatRGB555, FormatRGB565>(),
+		makeStaticCrossBlit<FormatRGB565, FormatRGB555>(),
+
+		makeStaticCrossBlit<FormatRGB565, FormatRGBA8888>(),
+		makeStaticCrossBlit<FormatRGB565, FormatARGB8888>(),
+		makeStaticCrossBlit<FormatRGB565, FormatABGR8888>(),
+		makeStaticCrossBlit<FormatRGB565, FormatBGRA8888>(),
+		makeStaticCrossBlit<FormatRGB555, FormatRGBA8888>(),
+		makeStaticCrossBlit<FormatRGB555, FormatARGB8888>(),
+		makeStaticCrossBlit<FormatRGB555, FormatABGR8888>(),
+		makeStaticCrossBlit<FormatRGB555, FormatBGRA8888>(),
+
+		makeStaticCrossBlit<FormatRGBA8888, FormatRGB565>(),
+		makeStaticCrossBlit<FormatARGB8888, FormatRGB565>(),
+		makeStaticCrossBlit<FormatABGR8888, FormatRGB565>(),
+		makeStaticCrossBlit<FormatBGRA8888, FormatRGB565>(),
+		makeStaticCrossBlit<FormatRGBA8888, FormatRGB555>(),
+		makeStaticCrossBlit<FormatARGB8888, FormatRGB555>(),
+		makeStaticCrossBlit<FormatABGR8888, FormatRGB555>(),
+		makeStaticCrossBlit<FormatBGRA8888, FormatRGB555>(),
+
+		makeStaticCrossBlit<FormatRGBA8888, FormatARGB8888>(),
+		makeStaticCrossBlit<FormatRGBA8888, FormatABGR8888>(),
+		makeStaticCrossBlit<FormatRGBA8888, FormatBGRA8888>(),
+		makeStaticCrossBlit<FormatARGB8888, FormatRGBA8888>(),
+		makeStaticCrossBlit<FormatARGB8888, FormatABGR8888>(),
+		makeStaticCrossBlit<FormatARGB8888, FormatBGRA8888>(),
+		makeStaticCrossBlit<FormatABGR8888, FormatRGBA8888>(),
+		makeStaticCrossBlit<FormatABGR8888, FormatARGB8888>(),
+		makeStaticCrossBlit<FormatABGR8888, FormatBGRA8888>(),
+		makeStaticCrossBlit<FormatBGRA8888, FormatRGBA8888>(),
+		makeStaticCrossBlit<FormatBGRA8888, FormatARGB8888>(),
+		makeStaticCrossBlit<FormatBGRA8888, FormatABGR8888>()
+	};
+
+	count = ARRAYSIZE(staticCrossBlits);
+	return staticCrossBlits;
+}
+
+CrossBlitFunc findStaticCrossBlit(const PixelFormat &srcFmt, const PixelFormat &dstFmt) {
+	uint count;
+	const StaticCrossBlit *entries = getStaticCrossBlits(count);
+
+	for (uint i = 0; i < count; ++i) {
+		if (entries[i].srcFmt == srcFmt && entries[i].dstFmt == dstFmt)
+			return entries[i].func;
+	}
+
+	return nullptr;
+}
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -127,17 +277,36 @@ bool crossBlit(byte *dst, const byte *src,
 	}
 
 	// Faster, but larger, to provide optimized handling for each case.
+	uint width = w, height = h;
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
 
-	// TODO: optimized cases for dstDelta of 0
+	// Contiguous areas can be converted as one long row
+	if (srcDelta == 0 && dstDelta == 0) {
+		width *= height;
+		height = 1;
+	}
+
+	// Use a specialized conversion for the common formats if possible
+	CrossBlitFunc staticCrossBlit = findStaticCrossBlit(srcFmt, dstFmt);
+	if (staticCrossBlit) {
+		if (dstFmt.bytesPerPixel > srcFmt.bytesPerPixel) {
+			dst += (height - 1) * dstPitch + (width - 1) * dstFmt.bytesPerPixel;
+			src += (height - 1) * srcPitch + (width - 1) * srcFmt.bytesPerPixel;
+		}
+		staticCrossBlit(dst, src, width, height, srcDelta, dstDelta);
+		return true;
+	}
+
+	const GenericColorConverter convert(srcFmt, dstFmt);
+
 	if (dstFmt.bytesPerPixel == 2) {
 		if (srcFmt.bytesPerPixel == 2) {
-			crossBlitLogic<uint16, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogic<uint16, uint16, false>(dst, src, width, height, convert, srcDelta, dstDelta);
 		} else if (srcFmt.bytesPerPixel == 3) {
-			crossBlitLogic3BppSource<uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogic3BppSource<uint16, false>(dst, src, width, height, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else {
-			crossBlitLogic<uint32, uint16, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogic<uint32, uint16, false>(dst, src, width, height, convert, srcDelta, dstDelta);
 		}
 	} else if (dstFmt.bytesPerPixel == 4) {
 		if (srcFmt.bytesPerPixel == 2) {
@@ -146,20 +315,20 @@ bool crossBlit(byte *dst, const byte *src,
 			// buffer copying the surface from top left to bottom right would
 			// overwrite the source, since we have more bits per destination
 			// color than per source color.
-			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
-			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
-			crossBlitLogic<uint16, uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			dst += (height - 1) * dstPitch + (width - 1) * dstFmt.bytesPerPixel;
+			src += (height - 1) * srcPitch + (width - 1) * srcFmt.bytesPerPixel;
+			crossBlitLogic<uint16, uint32, true>(dst, src, width, height, convert, srcDelta, dstDelta);
 		} else if (srcFmt.bytesPerPixel == 3) {
 			// We need to blit the surface from bottom right to top left here.
 			// This is neeeded, because when we convert to the same memory
 			// buffer copying the surface from top left to bottom right would
 			// overwrite the source, since we have more bits per destination
 			// color than per source color.
-			dst += h * dstPitch - dstDelta - dstFmt.bytesPerPixel;
-			src += h * srcPitch - srcDelta - srcFmt.bytesPerPixel;
-			crossBlitLogic3BppSource<uint32, true>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			dst += (height - 1) * dstPitch + (width - 1) * dstFmt.bytesPerPixel;
+			src += (height - 1) * srcPitch + (width - 1) * srcFmt.bytesPerPixel;
+			crossBlitLogic3BppSource<uint32, true>(dst, src, width, height, srcFmt, dstFmt, srcDelta, dstDelta);
 		} else {
-			crossBlitLogic<uint32, uint32, false>(dst, src, w, h, srcFmt, dstFmt, srcDelta, dstDelta);
+			crossBlitLogic<uint32, uint32, false>(dst, src, width, height, convert, srcDelta, dstDelta);
 		}
 	} else {
 		return false;
@@ -24,6 +24,7 @@
 #include "graphics/managed_surface.h"
 
 #include "common/array.h"
+#include "common/hashmap.h"
 #include "common/util.h"
 
 namespace Graphics {
@@ -230,8 +231,130 @@ int wordWrapTextImpl(const Font &font, const StringType &str, int maxWidth, Comm
 	return wrapper.actualMaxLineWidth;
 }
 
+/**
+ * The results of recent word wrapping calls, looked up by string and widths.
+ * When full, the least recently used result is replaced.
+ */
+template<class StringType>
+class WordWrapResults {
+public:
+	WordWrapResults() : _maxEntries(0), _useCounter(0) {}
+
+	void setMaxEntries(uint maxEntries) {
+		_maxEntries = maxEntries;
+		while (_entries.size() > _maxEntries)
+			evictLeastRecentlyUsed();
+	}
+
+	bool lookup(const StringType &str, int maxWidth, int initWidth, Common::Array<StringType> &lines, int &width) {
+		Key key;
+		key.str = str;
+		key.maxWidth = maxWidth;
+		key.initWidth = initWidth;
+
+		typename EntryMap::iterator i = _entries.find(key);
+		if (i == _entries.end())
+			return false;
+
+		lines.push_back(i->_value.lines);
+		width = i->_value.width;
+		i->_value.lastUse = ++_useCounter;
+		return true;
+	}
+
+	void insert(const StringType &str, int maxWidth, int initWidth, const StringType *lines, uint count, int width) {
+		if (!_maxEntries)
+			return;
+
+		if (_entries.size() >= _maxEntries)
+			evictLeastRecentlyUsed();
+
+		Key key;
+		key.str = str;
+		key.maxWidth = maxWidth;
+		key.initWidth = initWidth;
+
+		Entry &entry = _entries[key];
+		entry.lines.clear();
+		for (uint i = 0; i < count; ++i)
+			entry.lines.push_back(lines[i]);
+		entry.width = width;
+		entry.lastUse = ++_useCounter;
+	}
+
+	void clear() {
+		_entries.clear();
+	}
+
+private:
+	struct Key {
+		StringType str;
+		int maxWidth, initWidth;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			uint hash = key.maxWidth * 31 + key.initWidth;
+			for (uint i = 0; i < key.str.size(); ++i)
+				hash = hash * 1000003 ^ (uint)key.str[i];
+			return hash;
+		}
+	};
+
+	struct KeyEqualTo {
+		bool operator()(const Key &a, const Key &b) const {
+			return a.maxWidth == b.maxWidth && a.initWidth == b.initWidth && a.str == b.str;
+		}
+	};
+
+	struct Entry {
+		Common::Array<StringType> lines;
+		int width;
+		uint lastUse;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash, KeyEqualTo> EntryMap;
+
+	// Only called when inserting a new result, which is much less frequent
+	// than looking one up, so a linear search is fine here
+	void evictLeastRecentlyUsed() {
+		typename EntryMap::iterator oldest = _entries.begin();
+		for (typename EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+		if (oldest != _entries.end())
+			_entries.erase(oldest);
+	}
+
+	EntryMap _entries;
+	uint _maxEntries;
+	uint _useCounter;
+};
+
+template<class StringType>
+int wordWrapTextCached(const Font &font, WordWrapResults<StringType> *cache, const StringType &str, int maxWidth, Common::Array<StringType> &lines, int initWidth) {
+	if (!cache)
+		return wordWrapTextImpl(font, str, maxWidth, lines, initWidth);
+
+	int width;
+	if (cache->lookup(str, maxWidth, initWidth, lines, width))
+		return width;
+
+	const uint firstLine = lines.size();
+	width = wordWrapTextImpl(font, str, maxWidth, lines, initWidth);
+	cache->insert(str, maxWidth, initWidth, lines.begin() + firstLine, lines.size() - firstLine, width);
+	return width;
+}
+
 } // End of anonymous namespace
 
+class Font::WordWrapCache {
+public:
+	WordWrapResults<Common::String> _strings;
+	WordWrapResults<Common::U32String> _u32Strings;
+};
+
 Common::Rect Font::getBoundingBox(const Common::String &input, int x, int y, const int w, TextAlign align, int deltax, bool useEllipsis) const {
 	// In case no width was given we cannot use ellipsis or any alignment
 	// apart from left alignment.
@@ -306,11 +429,31 @@ void Font::drawString(ManagedSurface *dst, const Common::U32String &str, int x,
 }
 
 int Font::wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth);
+	return wordWrapTextCached(*this, _wordWrapCache ? &_wordWrapCache->_strings : nullptr, str, maxWidth, lines, initWidth);
 }
 
 int Font::wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth) const {
-	return wordWrapTextImpl(*this, str, maxWidth, lines, initWidth);
+	return wordWrapTextCached(*this, _wordWrapCache ? &_wordWrapCache->_u32Strings : nullptr, str, maxWidth, lines, initWidth);
+}
+
+void Font::setWordWrapCacheSize(uint maxEntries) const {
+	if (!maxEntries) {
+		_wordWrapCache.reset();
+		return;
+	}
+
+	if (!_wordWrapCache)
+		_wordWrapCache = Common::SharedPtr<WordWrapCache>(new WordWrapCache());
+
+	_wordWrapCache->_strings.setMaxEntries(maxEntries);
+	_wordWrapCache->_u32Strings.setMaxEntries(maxEntries);
+}
+
+void Font::invalidateLayoutCache() const {
+	if (_wordWrapCache) {
+		_wordWrapCache->_strings.clear();
+		_wordWrapCache->_u32Strings.clear();
+	}
 }
 
 Common::String Font::handleEllipsis(const Common::String &input, int w) const {
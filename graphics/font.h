@@ -23,14 +23,12 @@
 #ifndef GRAPHICS_FONT_H
 #define GRAPHICS_FONT_H
 
+#include "common/array.h"
+#include "common/ptr.h"
 #include "common/str.h"
 #include "common/ustr.h"
 #include "common/rect.h"
 
-namespace Common {
-template<class T> class Array;
-}
-
 namespace Graphics {
 
 struct Surface;
@@ -178,8 +176,27 @@ public:
 	int wordWrapText(const Common::String &str, int maxWidth, Common::Array<Common::String> &lines, int initWidth = 0) const;
 	int wordWrapText(const Common::U32String &str, int maxWidth, Common::Array<Common::U32String> &lines, int initWidth = 0) const;
 
+	/**
+	 * Keep the results of the most recent wordWrapText calls, so that
+	 * wrapping the same text to the same width again, for example every
+	 * frame, only copies the lines. Caching is disabled by default; the
+	 * GUI enables it for the fonts of its theme.
+	 *
+	 * @param maxEntries the number of results to keep, 0 disables the cache
+	 */
+	void setWordWrapCacheSize(uint maxEntries) const;
+
+	/**
+	 * Forget all cached word wrapping results. Fonts whose character widths
+	 * can change need to call this whenever they do.
+	 */
+	void invalidateLayoutCache() const;
+
 private:
 	Common::String handleEllipsis(const Common::String &str, int w) const;
+
+	class WordWrapCache;
+	mutable Common::SharedPtr<WordWrapCache> _wordWrapCache;
 };
 
 } // End of namespace Graphics
@@ -34,6 +34,7 @@
 #include "common/singleton.h"
 #include "common/stream.h"
 #include "common/memstream.h"
+#include "common/array.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
 
@@ -133,7 +134,7 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
+		Surface image; ///< Points into one of the atlas pages
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
@@ -143,7 +144,25 @@ private:
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
-	void assureCached(uint32 chr) const;
+	const Glyph *findGlyph(uint32 chr) const;
+
+	/**
+	 * The glyph images are packed into a few large pages rather than being
+	 * allocated one by one. Each page is filled row by row.
+	 */
+	struct AtlasPage {
+		Surface surface;
+		int x, y;
+		int rowHeight;
+	};
+
+	typedef Common::Array<AtlasPage *> Atlas;
+	mutable Atlas _atlas;
+	void allocateGlyphImage(Surface &image, int w, int h) const;
+
+	/** Kerning offsets by left and right glyph slot, see getKerningOffset() */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
 
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
@@ -169,8 +188,10 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (Atlas::iterator i = _atlas.begin(), end = _atlas.end(); i != end; ++i) {
+			(*i)->surface.free();
+			delete *i;
+		}
 
 		_initialized = false;
 	}
@@ -405,55 +426,53 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *leftGlyph = findGlyph(left);
+	if (!leftGlyph || !leftGlyph->slot)
 		return 0;
-	}
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *rightGlyph = findGlyph(right);
+	if (!rightGlyph || !rightGlyph->slot)
 		return 0;
-	}
 
-	if (!leftGlyph || !rightGlyph)
-		return 0;
+	// Glyph indices in TrueType and OpenType fonts are 16 bit, so a pair of
+	// them fits into a single key.
+	const bool cacheable = leftGlyph->slot <= 0xFFFF && rightGlyph->slot <= 0xFFFF;
+	const uint32 key = (leftGlyph->slot << 16) | rightGlyph->slot;
+	if (cacheable) {
+		KerningCache::const_iterator kerningEntry = _kerning.find(key);
+		if (kerningEntry != _kerning.end())
+			return kerningEntry->_value;
+	}
 
 	FT_Vector kerningVector;
-	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	FT_Get_Kerning(_face, leftGlyph->slot, rightGlyph->slot, FT_KERNING_DEFAULT, &kerningVector);
+	const int offset = kerningVector.x / 64;
+
+	if (cacheable)
+		_kerning[key] = offset;
+
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = findGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
+		const int xOffset = glyph->xOffset;
+		const int yOffset = glyph->yOffset;
+		const Graphics::Surface &image = glyph->image;
 		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
 	}
 }
@@ -497,12 +516,11 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphEntry = findGlyph(chr);
+	if (!glyphEntry)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphEntry;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -594,7 +612,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	glyph.advance = ftCeil26_6(_face->glyph->advance.x);
 
 	const FT_Bitmap &bitmap = _face->glyph->bitmap;
-	glyph.image.create(bitmap.width, bitmap.rows, PixelFormat::createFormatCLUT8());
+	if (bitmap.pixel_mode != FT_PIXEL_MODE_MONO && bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
+		return false;
+	}
+
+	allocateGlyphImage(glyph.image, bitmap.width, bitmap.rows);
 
 	const uint8 *src = bitmap.buffer;
 	int srcPitch = bitmap.pitch;
@@ -604,12 +627,12 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 	uint8 *dst = (uint8 *)glyph.image.getPixels();
-	memset(dst, 0, glyph.image.h * glyph.image.pitch);
 
 	switch (bitmap.pixel_mode) {
 	case FT_PIXEL_MODE_MONO:
 		for (int y = 0; y < (int)bitmap.rows; ++y) {
 			const uint8 *curSrc = src;
+			uint8 *curDst = dst;
 			uint8 mask = 0;
 
 			for (int x = 0; x < (int)bitmap.width; ++x) {
@@ -617,12 +640,13 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					*curDst = 255;
 
 				mask <<= 1;
-				++dst;
+				++curDst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
 		break;
@@ -634,25 +658,60 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 			src += srcPitch;
 		}
 		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap.pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 	return true;
 }
 
-void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
+void TTFFont::allocateGlyphImage(Surface &image, int w, int h) const {
+	const int pageSize = 256;
+
+	if (w == 0 || h == 0) {
+		image.init(w, h, 0, nullptr, PixelFormat::createFormatCLUT8());
 		return;
 	}
 
-	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
+	AtlasPage *page = _atlas.empty() ? nullptr : _atlas.back();
+
+	// Start a new row if the glyph does not fit into the current one
+	if (page && page->x + w > page->surface.w) {
+		page->x = 0;
+		page->y += page->rowHeight;
+		page->rowHeight = 0;
+	}
+
+	// Start a new page if the glyph does not fit into the current one. The
+	// pages are zero filled, so there is no need to clear the images.
+	if (!page || page->x + w > page->surface.w || page->y + h > page->surface.h) {
+		page = new AtlasPage();
+		page->surface.create(MAX(w, pageSize), MAX(h, pageSize), PixelFormat::createFormatCLUT8());
+		page->x = 0;
+		page->y = 0;
+		page->rowHeight = 0;
+		_atlas.push_back(page);
 	}
+
+	image.init(w, h, page->surface.pitch, page->surface.getBasePtr(page->x, page->y), PixelFormat::createFormatCLUT8());
+
+	page->x += w;
+	page->rowHeight = MAX(page->rowHeight, h);
+}
+
+const TTFFont::Glyph *TTFFont::findGlyph(uint32 chr) const {
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry != _glyphs.end())
+		return &glyphEntry->_value;
+
+	if (!chr || !_allowLateCaching)
+		return nullptr;
+
+	Glyph newGlyph;
+	if (!cacheGlyph(newGlyph, chr))
+		return nullptr;
+
+	Glyph &glyph = _glyphs[chr];
+	glyph = newGlyph;
+	return &glyph;
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
@@ -29,6 +29,7 @@ MODULE_OBJS := \
 	screen.o \
 	sjis.o \
 	surface.o \
+	transform_cache.o \
 	transform_struct.o \
 	transform_tools.o \
 	transparent_surface.o \
@@ -27,15 +27,27 @@
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+/**
+ * How many percent of the pixels of two nearby dirty rects the union of
+ * both may add before they are no longer merged
+ */
+#define MERGE_WASTE_PERCENT 25
+
+/**
+ * How many percent of the screen need to be dirty before all of it is
+ * copied in one go
+ */
+#define FULL_UPDATE_PERCENT 75
+
+Screen::Screen(): ManagedSurface(), _updateBytes(0), _updateRectCount(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _updateBytes(0), _updateRectCount(0) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _updateBytes(0), _updateRectCount(0) {
 	create(width, height, pixelFormat);
 }
 
@@ -43,13 +55,29 @@ void Screen::update() {
 	// Merge the dirty rects
 	mergeDirtyRects();
 
-	// Loop through copying dirty areas to the physical screen
+	// When most of the screen is dirty, a single copy of all of it is
+	// cheaper than many smaller ones
+	uint32 dirtyArea = 0;
 	Common::List<Common::Rect>::iterator i;
+	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+		dirtyArea += rectArea(*i);
+
+	if (dirtyArea >= rectArea(getBounds()) * FULL_UPDATE_PERCENT / 100) {
+		_dirtyRects.clear();
+		_dirtyRects.push_back(getBounds());
+	}
+
+	// Loop through copying dirty areas to the physical screen
+	_updateBytes = 0;
+	_updateRectCount = 0;
 	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
 		const Common::Rect &r = *i;
 		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
 		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
 			r.width(), r.height());
+
+		_updateBytes += rectArea(r) * format.bytesPerPixel;
+		++_updateRectCount;
 	}
 
 	// Signal the physical screen to update
@@ -74,23 +102,46 @@ void Screen::makeAllDirty() {
 void Screen::mergeDirtyRects() {
 	Common::List<Common::Rect>::iterator rOuter, rInner;
 
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+	// Process the dirty rect list to find any rects to merge. A merged
+	// rect may have grown into rects it was already compared against,
+	// so keep going until nothing changes
+	bool merged;
+	do {
+		merged = false;
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
+		for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
+			rInner = rOuter;
+			while (++rInner != _dirtyRects.end()) {
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+				if (shouldMergeRects(*rOuter, *rInner)) {
+					// Merge the two rectangles
+					unionRectangle(*rOuter, *rOuter, *rInner);
 
-				// move back to beginning of list
-				rInner = rOuter;
+					// remove the inner rect from the list
+					_dirtyRects.erase(rInner);
+
+					// move back to beginning of list
+					rInner = rOuter;
+					merged = true;
+				}
 			}
 		}
-	}
+	} while (merged);
+}
+
+bool Screen::shouldMergeRects(const Common::Rect &r1, const Common::Rect &r2) {
+	// Overlapping rects are always merged, to avoid copying the same
+	// pixels twice
+	if (r1.intersects(r2))
+		return true;
+
+	// Otherwise merge touching or nearby rects as long as the union does not
+	// copy too many pixels that neither of them covers
+	Common::Rect merged = r1;
+	merged.extend(r2);
+
+	uint32 area = rectArea(r1) + rectArea(r2);
+	return rectArea(merged) <= area + area * MERGE_WASTE_PERCENT / 100;
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
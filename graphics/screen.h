@@ -45,12 +45,28 @@ private:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Number of bytes and rects copied by the last update
+	 */
+	uint32 _updateBytes;
+	uint _updateRectCount;
 private:
 	/**
-	* Merges together overlapping dirty areas of the screen
+	* Merges together overlapping and nearby dirty areas of the screen
 	*/
 	void mergeDirtyRects();
 
+	/**
+	* Returns true if two dirty areas are better copied as one
+	*/
+	bool shouldMergeRects(const Common::Rect &r1, const Common::Rect &r2);
+
+	/**
+	* Returns the area of a rectangle
+	*/
+	static uint32 rectArea(const Common::Rect &r) { return (uint32)r.width() * r.height(); }
+
 	/**
 	* Returns the union of two dirty area rectangles
 	*/
@@ -87,6 +103,16 @@ public:
 	 */
 	virtual void update();
 
+	/**
+	 * Returns the number of bytes copied to the system by the last update
+	 */
+	uint32 getUpdateBytes() const { return _updateBytes; }
+
+	/**
+	 * Returns the number of rects copied to the system by the last update
+	 */
+	uint getUpdateRectCount() const { return _updateRectCount; }
+
 	/**
 	 * Return the currently active palette
 	 */
@@ -354,6 +354,11 @@ void Surface::move(int dx, int dy, int height) {
 	}
 }
 
+static void convertPaletteToMap(uint32 *map, const byte *palette, const PixelFormat &format) {
+	for (int i = 0; i < 256; i++)
+		map[i] = format.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+}
+
 void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette) {
 	// Do not convert to the same format and ignore empty surfaces.
 	if (format == dstFormat || pixels == 0) {
@@ -382,17 +387,15 @@ void Surface::convertToInPlace(const PixelFormat &dstFormat, const byte *palette
 	if (format.bytesPerPixel == 1) {
 		assert(palette);
 
+		uint32 map[256];
+		convertPaletteToMap(map, palette, dstFormat);
+
 		for (int y = h; y > 0; --y) {
 			const byte *srcRow = (const byte *)pixels + y * pitch - 1;
 			byte *dstRow = (byte *)pixels + y * w * dstFormat.bytesPerPixel - dstFormat.bytesPerPixel;
 
 			for (int x = 0; x < w; x++) {
-				byte index = *srcRow--;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
+				uint32 color = map[*srcRow--];
 
 				if (dstFormat.bytesPerPixel == 2)
 					*((uint16 *)dstRow) = color;
@@ -443,17 +446,15 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 		// Converting from paletted to high color
 		assert(palette);
 
+		uint32 map[256];
+		convertPaletteToMap(map, palette, dstFormat);
+
 		for (int y = 0; y < h; y++) {
 			const byte *srcRow = (const byte *)getBasePtr(0, y);
 			byte *dstRow = (byte *)surface->getBasePtr(0, y);
 
 			for (int x = 0; x < w; x++) {
-				byte index = *srcRow++;
-				byte r = palette[index * 3];
-				byte g = palette[index * 3 + 1];
-				byte b = palette[index * 3 + 2];
-
-				uint32 color = dstFormat.RGBToColor(r, g, b);
+				uint32 color = map[*srcRow++];
 
 				if (dstFormat.bytesPerPixel == 2)
 					*((uint16 *)dstRow) = color;
@@ -465,34 +466,7 @@ Graphics::Surface *Surface::convertTo(const PixelFormat &dstFormat, const byte *
 		}
 	} else {
 		// Converting from high color to high color
-		for (int y = 0; y < h; y++) {
-			const byte *srcRow = (const byte *)getBasePtr(0, y);
-			byte *dstRow = (byte *)surface->getBasePtr(0, y);
-
-			for (int x = 0; x < w; x++) {
-				uint32 srcColor;
-				if (format.bytesPerPixel == 2)
-					srcColor = READ_UINT16(srcRow);
-				else if (format.bytesPerPixel == 3)
-					srcColor = READ_UINT24(srcRow);
-				else
-					srcColor = READ_UINT32(srcRow);
-
-				srcRow += format.bytesPerPixel;
-
-				// Convert that color to the new format
-				byte r, g, b, a;
-				format.colorToARGB(srcColor, a, r, g, b);
-				uint32 color = dstFormat.ARGBToColor(a, r, g, b);
-
-				if (dstFormat.bytesPerPixel == 2)
-					*((uint16 *)dstRow) = color;
-				else
-					*((uint32 *)dstRow) = color;
-
-				dstRow += dstFormat.bytesPerPixel;
-			}
-		}
+		crossBlit((byte *)surface->getPixels(), (const byte *)getPixels(), surface->pitch, pitch, w, h, dstFormat, format);
 	}
 
 	return surface;
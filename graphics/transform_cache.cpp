@@ -0,0 +1,201 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/transform_cache.h"
+
+namespace Graphics {
+
+namespace {
+
+/**
+ * Frees the results, which are TransparentSurfaces. SurfaceDeleter would
+ * delete them through a Surface pointer, which has no virtual destructor.
+ */
+struct TransparentSurfaceDeleter {
+	void operator()(TransparentSurface *ptr) {
+		if (ptr)
+			ptr->free();
+		delete ptr;
+	}
+};
+
+} // End of anonymous namespace
+
+bool TransformCache::Key::operator==(const Key &other) const {
+	return owner == other.owner &&
+	       srcRect == other.srcRect &&
+	       width == other.width &&
+	       height == other.height &&
+	       angle == other.angle &&
+	       zoom == other.zoom &&
+	       hotspot == other.hotspot &&
+	       filteringMode == other.filteringMode;
+}
+
+uint TransformCache::KeyHash::operator()(const Key &key) const {
+	uint hash = (uint)(size_t)key.owner;
+	hash = hash * 31 + (uint)(key.srcRect.left ^ (key.srcRect.top << 16));
+	hash = hash * 31 + (uint)(key.srcRect.right ^ (key.srcRect.bottom << 16));
+	hash = hash * 31 + (uint)(key.width ^ (key.height << 16));
+	hash = hash * 31 + (uint)key.angle;
+	hash = hash * 31 + (uint)(key.zoom.x ^ (key.zoom.y << 16));
+	hash = hash * 31 + (uint)(key.hotspot.x ^ (key.hotspot.y << 16));
+	return hash * 2 + (uint)key.filteringMode;
+}
+
+TransformCache::TransformCache(uint32 maxBytes) : _size(0), _maxBytes(maxBytes) {
+}
+
+TransformCache::~TransformCache() {
+	clear();
+}
+
+TransformCache::SurfacePtr TransformCache::scale(const void *owner, const Surface &src, const Common::Rect &srcRect,
+                                                 uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode) {
+	Key key;
+	key.owner = owner;
+	key.srcRect = srcRect;
+	key.width = newWidth;
+	key.height = newHeight;
+	key.angle = kDefaultAngle;
+	key.zoom = Common::Point(kDefaultZoomX, kDefaultZoomY);
+	key.hotspot = Common::Point(kDefaultHotspotX, kDefaultHotspotY);
+	key.filteringMode = filteringMode;
+
+	SurfacePtr result = lookup(key);
+	if (result)
+		return result;
+
+	TransparentSurface *area = copyArea(src, srcRect);
+	TransparentSurface *scaled;
+	if (filteringMode == FILTER_BILINEAR)
+		scaled = area->scaleT<FILTER_BILINEAR>(newWidth, newHeight);
+	else
+		scaled = area->scaleT<FILTER_NEAREST>(newWidth, newHeight);
+	area->free();
+	delete area;
+
+	return insert(key, scaled);
+}
+
+TransformCache::SurfacePtr TransformCache::rotoscale(const void *owner, const Surface &src, const Common::Rect &srcRect,
+                                                     const TransformStruct &transform, TFilteringMode filteringMode) {
+	Key key;
+	key.owner = owner;
+	key.srcRect = srcRect;
+	key.width = 0;
+	key.height = 0;
+	key.angle = transform._angle;
+	key.zoom = transform._zoom;
+	key.hotspot = transform._hotspot;
+	key.filteringMode = filteringMode;
+
+	SurfacePtr result = lookup(key);
+	if (result)
+		return result;
+
+	TransparentSurface *area = copyArea(src, srcRect);
+	TransparentSurface *rotated;
+	if (filteringMode == FILTER_BILINEAR)
+		rotated = area->rotoscaleT<FILTER_BILINEAR>(transform);
+	else
+		rotated = area->rotoscaleT<FILTER_NEAREST>(transform);
+	area->free();
+	delete area;
+
+	return insert(key, rotated);
+}
+
+void TransformCache::invalidate(const void *owner) {
+	EntryList::iterator it = _entries.begin();
+	while (it != _entries.end()) {
+		EntryList::iterator next = it;
+		++next;
+		if (it->key.owner == owner)
+			erase(it);
+		it = next;
+	}
+}
+
+void TransformCache::clear() {
+	_entries.clear();
+	_map.clear();
+	_size = 0;
+}
+
+TransformCache::SurfacePtr TransformCache::lookup(const Key &key) {
+	EntryMap::iterator it = _map.find(key);
+	if (it == _map.end())
+		return SurfacePtr();
+
+	// Move the entry to the front, keeping the list in LRU order
+	EntryList::iterator entry = it->_value;
+	if (entry != _entries.begin()) {
+		_entries.push_front(*entry);
+		_entries.erase(entry);
+		it->_value = _entries.begin();
+	}
+
+	return _entries.front().surface;
+}
+
+TransformCache::SurfacePtr TransformCache::insert(const Key &key, TransparentSurface *surface) {
+	SurfacePtr result(surface, TransparentSurfaceDeleter());
+
+	uint32 size = surface->pitch * surface->h;
+	if (size > _maxBytes)
+		return result;
+
+	while (_size + size > _maxBytes)
+		erase(--_entries.end());
+
+	Entry entry;
+	entry.key = key;
+	entry.surface = result;
+	entry.size = size;
+	_entries.push_front(entry);
+	_map[key] = _entries.begin();
+	_size += size;
+
+	return result;
+}
+
+void TransformCache::erase(EntryList::iterator it) {
+	_size -= it->size;
+	_map.erase(it->key);
+	_entries.erase(it);
+}
+
+TransparentSurface *TransformCache::copyArea(const Surface &src, const Common::Rect &srcRect) const {
+	assert(src.format.bytesPerPixel == 4);
+
+	// The scalers expect the pitch to match the width, so the area cannot
+	// simply be referenced in place.
+	TransparentSurface *area = new TransparentSurface();
+	area->create((uint16)srcRect.width(), (uint16)srcRect.height(), src.format);
+	for (int y = 0; y < area->h; y++)
+		memcpy(area->getBasePtr(0, y), src.getBasePtr(srcRect.left, srcRect.top + y), area->w * 4);
+
+	return area;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,131 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef GRAPHICS_TRANSFORM_CACHE_H
+#define GRAPHICS_TRANSFORM_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/rect.h"
+
+#include "graphics/transparent_surface.h"
+
+namespace Graphics {
+
+/**
+ * A cache for the results of TransparentSurface::scaleT() and rotoscaleT().
+ *
+ * Sprites tend to be drawn with the same zoom and rotation frame after
+ * frame, so the transformed pixels are kept here and handed out again as
+ * long as the source does not change. Results are keyed by an opaque
+ * owner pointer, the source rectangle and the transformation parameters.
+ *
+ * The cache holds at most a given number of bytes of pixel data; the least
+ * recently used results are dropped first. Results are reference counted,
+ * so a dropped result stays valid for whoever still holds it.
+ *
+ * The owner is responsible for calling invalidate() whenever the source
+ * pixels change and before the source is destroyed.
+ */
+class TransformCache {
+public:
+	typedef Common::SharedPtr<Surface> SurfacePtr;
+
+	/**
+	 * Create a cache holding at most maxBytes bytes of pixel data.
+	 */
+	TransformCache(uint32 maxBytes);
+	~TransformCache();
+
+	/**
+	 * Get the srcRect area of a 32bpp source surface scaled to the given
+	 * size, transforming it only if no matching result is cached.
+	 */
+	SurfacePtr scale(const void *owner, const Surface &src, const Common::Rect &srcRect,
+	                 uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode);
+
+	/**
+	 * Get the srcRect area of a 32bpp source surface rotated and zoomed as
+	 * described by the transform, transforming it only if no matching
+	 * result is cached. Only the angle, zoom and hotspot of the transform
+	 * are taken into account, as these are all rotoscaleT() uses.
+	 */
+	SurfacePtr rotoscale(const void *owner, const Surface &src, const Common::Rect &srcRect,
+	                     const TransformStruct &transform, TFilteringMode filteringMode);
+
+	/**
+	 * Drop all results belonging to the given owner.
+	 */
+	void invalidate(const void *owner);
+
+	/**
+	 * Drop all results.
+	 */
+	void clear();
+
+	/**
+	 * Return the number of bytes of pixel data currently cached.
+	 */
+	uint32 getSize() const { return _size; }
+
+private:
+	struct Key {
+		const void *owner;
+		Common::Rect srcRect;
+		uint16 width, height;
+		int32 angle;
+		Common::Point zoom;
+		Common::Point hotspot;
+		TFilteringMode filteringMode;
+
+		bool operator==(const Key &other) const;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	struct Entry {
+		Key key;
+		SurfacePtr surface;
+		uint32 size;
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	/** The cached results, most recently used first. */
+	EntryList _entries;
+	EntryMap _map;
+	uint32 _size;
+	uint32 _maxBytes;
+
+	SurfacePtr lookup(const Key &key);
+	SurfacePtr insert(const Key &key, TransparentSurface *surface);
+	void erase(EntryList::iterator it);
+	TransparentSurface *copyArea(const Surface &src, const Common::Rect &srcRect) const;
+};
+
+} // End of namespace Graphics
+
+#endif
@@ -37,6 +37,13 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/transform_tools.h"
 
+// The SSE2 blending code assumes the alpha is stored in the lowest byte
+// of every pixel, as is the case for the little endian kAIndex below.
+#if defined(__SSE2__) && defined(SCUMM_LITTLE_ENDIAN)
+#define USE_SSE2_BLENDING
+#include <emmintrin.h>
+#endif
+
 namespace Graphics {
 
 static const int kBModShift = 0;//img->format.bShift;
@@ -64,6 +71,145 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 
+#ifdef USE_SSE2_BLENDING
+/*
+ * SSE2 versions of the inner blending loops for the common cases without
+ * colormod, which handle four pixels per iteration. They only support
+ * unflipped source rows, produce exactly the same results as the scalar
+ * code, and return how many pixels they have handled; the remaining
+ * pixels of the row are left to the scalar code.
+ */
+namespace {
+
+/**
+ * Replicate the alpha of both pixels in the 16 bit lanes to all lanes of
+ * that pixel.
+ */
+inline __m128i expandAlpha(__m128i px) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+/**
+ * Multiply every channel with the pixel's alpha, shifted down by 8.
+ */
+inline __m128i premultiply(__m128i px) {
+	return _mm_srli_epi16(_mm_mullo_epi16(px, expandAlpha(px)), 8);
+}
+
+/**
+ * Use the new value for pixels with non-zero source alpha, and keep the
+ * old one for the others.
+ */
+inline __m128i selectOpaque(__m128i src, __m128i oldValue, __m128i newValue) {
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	__m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), _mm_setzero_si128());
+	return _mm_or_si128(_mm_and_si128(transparent, oldValue), _mm_andnot_si128(transparent, newValue));
+}
+
+uint32 blitBinaryRowSSE2(const byte *in, byte *out, uint32 width) {
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const uint32 count = width & ~3;
+
+	for (uint32 j = 0; j < count; j += 4, in += 16, out += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i *)in);
+		__m128i dst = _mm_loadu_si128((const __m128i *)out);
+		_mm_storeu_si128((__m128i *)out, selectOpaque(src, dst, _mm_or_si128(src, alphaMask)));
+	}
+
+	return count;
+}
+
+uint32 blitAlphaBlendRowSSE2(const byte *in, byte *out, uint32 width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const __m128i max = _mm_set1_epi16(255);
+	const uint32 count = width & ~3;
+
+	for (uint32 j = 0; j < count; j += 4, in += 16, out += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i *)in);
+		__m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// (in * a + out * (255 - a)) >> 8 always fits in 16 bits
+		__m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		__m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		__m128i aLo = expandAlpha(srcLo);
+		__m128i aHi = expandAlpha(srcHi);
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(srcLo, aLo), _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(max, aLo)));
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(srcHi, aHi), _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(max, aHi)));
+
+		__m128i result = _mm_or_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), alphaMask);
+		_mm_storeu_si128((__m128i *)out, selectOpaque(src, dst, result));
+	}
+
+	return count;
+}
+
+uint32 blitAdditiveBlendRowSSE2(const byte *in, byte *out, uint32 width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const uint32 count = width & ~3;
+
+	for (uint32 j = 0; j < count; j += 4, in += 16, out += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i *)in);
+		__m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// The destination alpha is left as it is. Pixels with zero alpha
+		// add nothing, so they need no special handling.
+		__m128i add = _mm_packus_epi16(premultiply(_mm_unpacklo_epi8(src, zero)), premultiply(_mm_unpackhi_epi8(src, zero)));
+		add = _mm_andnot_si128(alphaMask, add);
+		_mm_storeu_si128((__m128i *)out, _mm_adds_epu8(dst, add));
+	}
+
+	return count;
+}
+
+uint32 blitSubtractiveBlendRowSSE2(const byte *in, byte *out, uint32 width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const uint32 count = width & ~3;
+
+	for (uint32 j = 0; j < count; j += 4, in += 16, out += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i *)in);
+		__m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// (in * out * a) >> 16 is the high half of (in * out) * a, and never
+		// exceeds out, so no clipping is needed. The destination alpha is left
+		// as it is, and pixels with zero alpha subtract nothing.
+		__m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		__m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		__m128i lo = _mm_mulhi_epu16(_mm_mullo_epi16(srcLo, _mm_unpacklo_epi8(dst, zero)), expandAlpha(srcLo));
+		__m128i hi = _mm_mulhi_epu16(_mm_mullo_epi16(srcHi, _mm_unpackhi_epi8(dst, zero)), expandAlpha(srcHi));
+		__m128i sub = _mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi));
+		_mm_storeu_si128((__m128i *)out, _mm_sub_epi8(dst, sub));
+	}
+
+	return count;
+}
+
+uint32 blitMultiplyBlendRowSSE2(const byte *in, byte *out, uint32 width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const uint32 count = width & ~3;
+
+	for (uint32 j = 0; j < count; j += 4, in += 16, out += 16) {
+		__m128i src = _mm_loadu_si128((const __m128i *)in);
+		__m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// ((in * a >> 8) * out) >> 8 never exceeds 254, so no clipping is needed
+		__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(premultiply(_mm_unpacklo_epi8(src, zero)), _mm_unpacklo_epi8(dst, zero)), 8);
+		__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(premultiply(_mm_unpackhi_epi8(src, zero)), _mm_unpackhi_epi8(dst, zero)), 8);
+
+		// The destination alpha is left as it is
+		__m128i result = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi)), _mm_and_si128(dst, alphaMask));
+		_mm_storeu_si128((__m128i *)out, selectOpaque(src, dst, result));
+	}
+
+	return count;
+}
+
+} // End of anonymous namespace
+#endif
+
 TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
 
 TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL) {
@@ -113,7 +259,15 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
-		for (uint32 j = 0; j < width; j++) {
+		uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+		if (inStep == 4) {
+			j = blitBinaryRowSSE2(in, out, width);
+			in += j * 4;
+			out += j * 4;
+		}
+#endif
+		for (; j < width; j++) {
 			uint32 pix = *(uint32 *)in;
 			int a = in[kAIndex];
 
@@ -149,7 +303,15 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			if (inStep == 4) {
+				j = blitAlphaBlendRowSSE2(in, out, width);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -207,7 +369,15 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			if (inStep == 4) {
+				j = blitAdditiveBlendRowSSE2(in, out, width);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) + out[kRIndex], 255);
@@ -274,7 +444,15 @@ void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height,
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			if (inStep == 4) {
+				j = blitSubtractiveBlendRowSSE2(in, out, width);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MAX(out[kRIndex] - ((in[kRIndex] * out[kRIndex]) * in[kAIndex] >> 16), 0);
@@ -338,7 +516,15 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef USE_SSE2_BLENDING
+			if (inStep == 4) {
+				j = blitMultiplyBlendRowSSE2(in, out, width);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kRIndex] = MIN((in[kRIndex] * in[kAIndex] >> 8) * out[kRIndex] >> 8, 255);
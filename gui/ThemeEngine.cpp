@@ -66,6 +66,10 @@ const char *const ThemeEngine::kImageOneDriveLogo = "onedrive.bmp";
 const char *const ThemeEngine::kImageGoogleDriveLogo = "googledrive.bmp";
 const char *const ThemeEngine::kImageBoxLogo = "box.bmp";
 
+// The number of word wrapping results the GUI fonts keep, since dialogs
+// wrap the same texts again whenever they are redrawn
+static const uint kFontWordWrapCacheSize = 32;
+
 struct TextDrawData {
 	const Graphics::Font *_fontPtr;
 };
@@ -374,7 +378,7 @@ void ThemeItemBitmapClip::drawSelf(bool draw, bool restore) {
  *********************************************************/
 ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(0), _vectorRenderer(0),
-	_buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
+	_backdropValid(false), _buffering(false), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(0) {
 
@@ -425,6 +429,7 @@ ThemeEngine::~ThemeEngine() {
 	_vectorRenderer = 0;
 	_screen.free();
 	_backBuffer.free();
+	_backdrop.free();
 
 	unloadTheme();
 
@@ -516,6 +521,7 @@ bool ThemeEngine::init() {
 	} else {
 		_font = FontMan.getFontByUsage(Graphics::FontManager::kGUIFont);
 	}
+	_font->setWordWrapCacheSize(kFontWordWrapCacheSize);
 
 	// Try to create a Common::Archive with the files of the theme.
 	if (!_themeArchive && !_themeFile.empty()) {
@@ -644,6 +650,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	_backdrop.free();
+	_backdropValid = false;
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -776,18 +785,15 @@ bool ThemeEngine::addBitmap(const Common::String &filename) {
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				if (!decoder.loadStream(*stream))
+				// Decode straight into the overlay format
+				surf = new Graphics::Surface();
+				if (!decoder.loadStreamInto(*stream, *surf, _overlayFormat))
 					error("Error decoding PNG");
 
-				srcSurface = decoder.getSurface();
 				delete stream;
-				if (srcSurface)
-					break;
+				break;
 			}
 		}
-
-		if (srcSurface && srcSurface->format.bytesPerPixel != 1)
-			surf = srcSurface->convertTo(_overlayFormat);
 #else
 		error("No PNG support compiled in");
 #endif
@@ -823,10 +829,6 @@ bool ThemeEngine::addAlphaBitmap(const Common::String &filename) {
 	if (surf)
 		return true;
 
-#ifdef USE_PNG
-	const Graphics::TransparentSurface *srcSurface = 0;
-#endif
-
 	if (filename.hasSuffix(".png")) {
 		// Maybe it is PNG?
 #ifdef USE_PNG
@@ -836,18 +838,15 @@ bool ThemeEngine::addAlphaBitmap(const Common::String &filename) {
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				if (!decoder.loadStream(*stream))
+				// Decode straight into the overlay format
+				surf = new Graphics::TransparentSurface();
+				if (!decoder.loadStreamInto(*stream, *surf, _overlayFormat))
 					error("Error decoding PNG");
 
-				srcSurface = new Graphics::TransparentSurface(*decoder.getSurface(), true);
 				delete stream;
-				if (srcSurface)
-					break;
+				break;
 			}
 		}
-
-		if (srcSurface && srcSurface->format.bytesPerPixel != 1)
-			surf = srcSurface->convertTo(_overlayFormat);
 #else
 		error("No PNG support compiled in");
 #endif
@@ -1942,6 +1941,26 @@ void ThemeEngine::openDialog(bool doBuffer, ShadingStyle style) {
 	_vectorRenderer->setSurface(&_screen);
 }
 
+void ThemeEngine::saveDialogBackdrop() {
+	if (_backdrop.w != _screen.w || _backdrop.h != _screen.h || _backdrop.format != _screen.format) {
+		_backdrop.free();
+		_backdrop.create(_screen.w, _screen.h, _screen.format);
+	}
+
+	memcpy(_backdrop.getPixels(), _screen.getPixels(), _screen.pitch * _screen.h);
+	_backdropValid = true;
+}
+
+bool ThemeEngine::restoreDialogBackdrop(bool moved) {
+	if (!_backdropValid)
+		return false;
+
+	memcpy(_screen.getPixels(), _backdrop.getPixels(), _screen.pitch * _screen.h);
+	if (moved)
+		addDirtyRect(Common::Rect(_screen.w, _screen.h));
+	return true;
+}
+
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
 	if (!_system->hasFeature(OSystem::kFeatureCursorPalette))
 		return true;
@@ -2149,6 +2168,7 @@ const Graphics::Font *ThemeEngine::loadFont(const Common::String &filename, cons
 
 	// If the font is successfully loaded store it in the font manager.
 	if (font) {
+		font->setWordWrapCacheSize(kFontWordWrapCacheSize);
 		FontMan.assignFontToName(fontName, font);
 		// If this font should be the new default localized font, we set it up
 		// for that.
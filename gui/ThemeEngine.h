@@ -318,6 +318,33 @@ public:
 	 */
 	void openDialog(bool enableBuffering, ShadingStyle shading = kShadingNone);
 
+	/**
+	 * Stores the current screen contents as the backdrop of the top dialog,
+	 * that is, everything that is drawn below it. Called right after the
+	 * top dialog has been opened with openDialog().
+	 */
+	void saveDialogBackdrop();
+
+	/**
+	 * Restores the screen contents stored by saveDialogBackdrop(), so that
+	 * the top dialog can be redrawn without redrawing all the dialogs below
+	 * it. Only the areas touched by the top dialog are then copied to the
+	 * overlay, unless it has moved or changed its size: then parts of the
+	 * screen it was drawn on before may no longer be covered by it, so the
+	 * whole screen is copied.
+	 *
+	 * @param moved whether the top dialog has moved or changed its size
+	 *              since it was last drawn.
+	 * @return true if a backdrop was restored, false if none is stored.
+	 */
+	bool restoreDialogBackdrop(bool moved);
+
+	/**
+	 * Forgets the stored backdrop. Must be called whenever anything below
+	 * the top dialog changes, e.g. when dialogs are opened or closed.
+	 */
+	void discardDialogBackdrop() { _backdropValid = false; }
+
 	/**
 	 * The updateScreen() method is called every frame.
 	 * It processes all the drawing queues and then copies dirty rects
@@ -695,6 +722,10 @@ protected:
 	/** Backbuffer surface. Stores previous states of the screen to blit back */
 	Graphics::TransparentSurface _backBuffer;
 
+	/** Screen contents below the top dialog, see saveDialogBackdrop() */
+	Graphics::Surface _backdrop;
+	bool _backdropValid;
+
 	/** Sets whether the current drawing is being buffered (stored for later
 	    processing) or drawn directly to the screen. */
 	bool _buffering;
@@ -220,9 +220,22 @@ void GuiManager::redraw() {
 		shading = ThemeEngine::kShadingNone;
 
 	switch (_redrawStatus) {
+		case kRedrawTopDialog: {
+			// The dialogs below have not changed, so only the top dialog
+			// needs to be drawn again on top of what was below it.
+			const Common::Rect area = getTopDialogArea();
+			if (_theme->restoreDialogBackdrop(area != _topDialogArea)) {
+				_topDialogArea = area;
+				_theme->openDialog(true, ThemeEngine::kShadingNone);
+				_dialogStack.top()->drawDialog();
+				_theme->finishBuffering();
+				break;
+			}
+		}
+			// fall through
+
 		case kRedrawCloseDialog:
 		case kRedrawFull:
-		case kRedrawTopDialog:
 			_theme->clearAll();
 			_theme->openDialog(true, ThemeEngine::kShadingNone);
 
@@ -236,6 +249,8 @@ void GuiManager::redraw() {
 		case kRedrawOpenDialog:
 			_theme->updateScreen(false);
 			_theme->openDialog(true, shading);
+			_theme->saveDialogBackdrop();
+			_topDialogArea = getTopDialogArea();
 			_dialogStack.top()->drawDialog();
 			_theme->finishBuffering();
 			break;
@@ -435,6 +450,7 @@ void GuiManager::openDialog(Dialog *dialog) {
 		getTopDialog()->lostFocus();
 
 	_dialogStack.push(dialog);
+	_theme->discardDialogBackdrop();
 	if (_redrawStatus != kRedrawFull)
 		_redrawStatus = kRedrawOpenDialog;
 
@@ -452,6 +468,7 @@ void GuiManager::closeTopDialog() {
 
 	// Remove the dialog from the stack
 	_dialogStack.pop()->lostFocus();
+	_theme->discardDialogBackdrop();
 
 	if (!_dialogStack.empty()) {
 		Dialog *dialog = getTopDialog();
@@ -514,6 +531,7 @@ void GuiManager::screenChange() {
 
 	// reinit the whole theme
 	_theme->refresh();
+	_theme->discardDialogBackdrop();
 
 	// refresh all dialogs
 	for (DialogStack::size_type i = 0; i < _dialogStack.size(); ++i) {
@@ -590,6 +608,11 @@ void GuiManager::processEvent(const Common::Event &event, Dialog *const activeDi
 	}
 }
 
+Common::Rect GuiManager::getTopDialogArea() const {
+	const Dialog *dialog = _dialogStack.top();
+	return Common::Rect(dialog->_x, dialog->_y, dialog->_x + dialog->_w, dialog->_y + dialog->_h);
+}
+
 void GuiManager::scheduleTopDialogRedraw() {
 	_redrawStatus = kRedrawTopDialog;
 }
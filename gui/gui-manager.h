@@ -125,6 +125,7 @@ protected:
 
 //	bool		_needRedraw;
 	RedrawStatus _redrawStatus;
+	Common::Rect	_topDialogArea;	// where the top dialog was drawn last
 	int			_lastScreenChangeID;
 	int			_width, _height;
 	DialogStack	_dialogStack;
@@ -133,6 +134,8 @@ protected:
 
 	bool		_useStdCursor;
 
+	Common::Rect getTopDialogArea() const;
+
 	// position and time of last mouse click (used to detect double clicks)
 	struct MousePos {
 		MousePos() : x(-1), y(-1), count(0) { time = 0; }
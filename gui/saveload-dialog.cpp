@@ -718,7 +718,7 @@ enum {
 
 SaveLoadChooserGrid::SaveLoadChooserGrid(const Common::String &title, bool saveMode)
 	: SaveLoadChooserDialog("SaveLoadChooser", saveMode), _lines(0), _columns(0), _entriesPerPage(0),
-	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons() {
+	_curPage(0), _newSaveContainer(0), _nextFreeSaveSlot(0), _buttons(), _pendingEntry(0) {
 	_backgroundType = ThemeEngine::kDialogBackgroundSpecial;
 
 	new StaticTextWidget(this, "SaveLoadChooser.Title", title);
@@ -801,6 +801,7 @@ void SaveLoadChooserGrid::handleMouseWheel(int x, int y, int direction) {
 
 void SaveLoadChooserGrid::updateSaveList() {
 	SaveLoadChooserDialog::updateSaveList();
+	_descriptorCache.clear();
 	updateSaves();
 	g_gui.scheduleTopDialogRedraw();
 }
@@ -808,6 +809,8 @@ void SaveLoadChooserGrid::updateSaveList() {
 void SaveLoadChooserGrid::open() {
 	SaveLoadChooserDialog::open();
 
+	// The saves might have changed since the dialog was last shown
+	_descriptorCache.clear();
 	listSaves();
 	_resultString.clear();
 
@@ -1043,61 +1046,104 @@ void SaveLoadChooserGrid::hideButtons() {
 	}
 }
 
-void SaveLoadChooserGrid::updateSaves() {
-	hideButtons();
+const SaveStateDescriptor *SaveLoadChooserGrid::getCachedDescriptor(uint entry) const {
+	const SaveStateDescriptor &desc = _saveList[entry];
+	if (desc.getLocked())
+		return &desc;
 
-	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
-		const uint saveSlot = _saveList[i].getSaveSlot();
+	DescriptorCache::const_iterator i = _descriptorCache.find(desc.getSaveSlot());
+	return i != _descriptorCache.end() ? &i->_value : 0;
+}
 
-		SaveStateDescriptor desc =  (_saveList[i].getLocked() ? _saveList[i] : _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot));
-		SlotButton &curButton = _buttons[curNum];
-		curButton.setVisible(true);
-		const Graphics::Surface *thumbnail = desc.getThumbnail();
-		if (thumbnail) {
-			curButton.button->setGfx(desc.getThumbnail());
-		} else {
-			curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
-		}
-		curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+void SaveLoadChooserGrid::loadNextDescriptor() {
+	// Load the meta infos of the current page first and then those of the
+	// next page, so that paging forward does not have to wait for them.
+	const uint end = MIN<uint>(_saveList.size(), (_curPage + 2) * _entriesPerPage);
 
-		Common::String tooltip(_("Name: "));
-		tooltip += desc.getDescription();
+	while (_pendingEntry < end && getCachedDescriptor(_pendingEntry))
+		++_pendingEntry;
 
-		if (_saveDateSupport) {
-			const Common::String &saveDate = desc.getSaveDate();
-			if (!saveDate.empty()) {
-				tooltip += "\n";
-				tooltip +=  _("Date: ") + saveDate;
-			}
+	if (_pendingEntry >= end)
+		return;
 
-			const Common::String &saveTime = desc.getSaveTime();
-			if (!saveTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Time: ") + saveTime;
-			}
-		}
+	const int saveSlot = _saveList[_pendingEntry].getSaveSlot();
+	const SaveStateDescriptor &desc = _descriptorCache[saveSlot] = _metaEngine->querySaveMetaInfos(_target.c_str(), saveSlot);
 
-		if (_playTimeSupport) {
-			const Common::String &playTime = desc.getPlayTime();
-			if (!playTime.empty()) {
-				tooltip += "\n";
-				tooltip += _("Playtime: ") + playTime;
-			}
+	const uint curNum = _pendingEntry - _curPage * _entriesPerPage;
+	if (curNum < _entriesPerPage)
+		updateSlotButton(_buttons[curNum], saveSlot, desc, true);
+
+	++_pendingEntry;
+}
+
+void SaveLoadChooserGrid::handleTickle() {
+	SaveLoadChooserDialog::handleTickle();
+
+	// Only query one save per tickle, to keep the dialog responsive
+	loadNextDescriptor();
+}
+
+void SaveLoadChooserGrid::updateSlotButton(SlotButton &curButton, int saveSlot, const SaveStateDescriptor &desc, bool queried) {
+	const Graphics::Surface *thumbnail = desc.getThumbnail();
+	if (thumbnail) {
+		curButton.button->setGfx(thumbnail);
+	} else {
+		curButton.button->setGfx(kThumbnailWidth, kThumbnailHeight2, 0, 0, 0);
+	}
+	curButton.button->markAsDirty();
+	curButton.description->setLabel(Common::String::format("%d. %s", saveSlot, desc.getDescription().c_str()));
+
+	Common::String tooltip(_("Name: "));
+	tooltip += desc.getDescription();
+
+	if (_saveDateSupport) {
+		const Common::String &saveDate = desc.getSaveDate();
+		if (!saveDate.empty()) {
+			tooltip += "\n";
+			tooltip +=  _("Date: ") + saveDate;
 		}
 
-		curButton.button->setTooltip(tooltip);
+		const Common::String &saveTime = desc.getSaveTime();
+		if (!saveTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Time: ") + saveTime;
+		}
+	}
 
-		// In save mode we disable the button, when it's write protected.
-		// TODO: Maybe we should not display it at all then?
-		if (_saveMode && desc.getWriteProtectedFlag()) {
-			curButton.button->setEnabled(false);
-		} else {
-			curButton.button->setEnabled(true);
+	if (_playTimeSupport) {
+		const Common::String &playTime = desc.getPlayTime();
+		if (!playTime.empty()) {
+			tooltip += "\n";
+			tooltip += _("Playtime: ") + playTime;
 		}
+	}
+
+	curButton.button->setTooltip(tooltip);
+
+	// In save mode we disable the button, when it's write protected. The
+	// descriptors from the save list do not tell, so the button stays
+	// disabled until the meta infos of the slot have been queried.
+	// TODO: Maybe we should not display it at all then?
+	const bool writeProtected = _saveMode && (!queried || desc.getWriteProtectedFlag());
+
+	//that would make it look "disabled" if slot is locked
+	curButton.button->setEnabled(!desc.getLocked() && !writeProtected);
+	curButton.description->setEnabled(!desc.getLocked());
+}
+
+void SaveLoadChooserGrid::updateSaves() {
+	hideButtons();
+
+	_pendingEntry = _curPage * _entriesPerPage;
+
+	for (uint i = _curPage * _entriesPerPage, curNum = 0; i < _saveList.size() && curNum < _entriesPerPage; ++i, ++curNum) {
+		SlotButton &curButton = _buttons[curNum];
+		curButton.setVisible(true);
 
-		//that would make it look "disabled" if slot is locked
-		curButton.button->setEnabled(!desc.getLocked());
-		curButton.description->setEnabled(!desc.getLocked());
+		// Show what the save list already tells us about the slot until
+		// handleTickle() has queried the full meta infos.
+		const SaveStateDescriptor *desc = getCachedDescriptor(i);
+		updateSlotButton(curButton, _saveList[i].getSaveSlot(), desc ? *desc : _saveList[i], desc != 0);
 	}
 
 	const uint numPages = (_entriesPerPage != 0 && !_saveList.empty()) ? ((_saveList.size() + _entriesPerPage - 1) / _entriesPerPage) : 1;
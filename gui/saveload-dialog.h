@@ -23,6 +23,8 @@
 #ifndef GUI_SAVELOAD_DIALOG_H
 #define GUI_SAVELOAD_DIALOG_H
 
+#include "common/hashmap.h"
+
 #include "gui/dialog.h"
 #include "gui/widgets/list.h"
 
@@ -206,6 +208,7 @@ public:
 protected:
 	virtual void handleCommand(CommandSender *sender, uint32 cmd, uint32 data);
 	virtual void handleMouseWheel(int x, int y, int direction);
+	virtual void handleTickle();
 	virtual void updateSaveList();
 private:
 	virtual int runIntern();
@@ -243,6 +246,16 @@ private:
 	void destroyButtons();
 	void hideButtons();
 	void updateSaves();
+	void updateSlotButton(SlotButton &curButton, int saveSlot, const SaveStateDescriptor &desc, bool queried);
+
+	typedef Common::HashMap<int, SaveStateDescriptor> DescriptorCache;
+	/** Meta infos queried so far, by save slot */
+	DescriptorCache _descriptorCache;
+	/** Index into _saveList from which on meta infos still have to be queried */
+	uint _pendingEntry;
+
+	const SaveStateDescriptor *getCachedDescriptor(uint entry) const;
+	void loadNextDescriptor();
 };
 
 #endif // !DISABLE_SAVELOADCHOOSER_GRID
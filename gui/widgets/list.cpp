@@ -162,6 +162,7 @@ void ListWidget::setList(const StringArray &list, const ColorList *colors) {
 	_list = list;
 	_filter.clear();
 	_listIndex.clear();
+	_searchIndex.clear();
 	_listColors.clear();
 
 	if (colors) {
@@ -194,9 +195,22 @@ void ListWidget::append(const String &s, ThemeEngine::FontColor color) {
 	}
 
 	_dataList.push_back(s);
-	_list.push_back(s);
 
-	setFilter(_filter, false);
+	if (_filter.empty()) {
+		_list.push_back(s);
+	} else {
+		// Only show the new entry if it matches the filter, and keep
+		// _listIndex complete, as narrowing the filter relies on it
+		StringArray tokens;
+		getFilterTokens(tokens);
+		updateSearchIndex();
+
+		const int n = _dataList.size() - 1;
+		if (matchesFilter(n, tokens)) {
+			_list.push_back(s);
+			_listIndex.push_back(n);
+		}
+	}
 
 	scrollBarRecalc();
 }
@@ -665,6 +679,31 @@ void ListWidget::reflowLayout() {
 	}
 }
 
+void ListWidget::updateSearchIndex() {
+	// Entries are only ever appended to the data list, and replacing it
+	// as a whole clears the index, so only missing entries need adding.
+	while (_searchIndex.size() < _dataList.size()) {
+		String entry = _dataList[_searchIndex.size()];
+		entry.toLowercase();
+		_searchIndex.push_back(entry);
+	}
+}
+
+void ListWidget::getFilterTokens(StringArray &tokens) const {
+	Common::StringTokenizer tok(_filter);
+	while (!tok.empty())
+		tokens.push_back(tok.nextToken());
+}
+
+bool ListWidget::matchesFilter(int n, const StringArray &tokens) const {
+	const String &entry = _searchIndex[n];
+	for (StringArray::const_iterator t = tokens.begin(); t != tokens.end(); ++t) {
+		if (!entry.contains(*t))
+			return false;
+	}
+	return true;
+}
+
 void ListWidget::setFilter(const String &filter, bool redraw) {
 	// FIXME: This method does not deal correctly with edit mode!
 	// Until we fix that, let's make sure it isn't called while editing takes place
@@ -676,6 +715,10 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	// Every entry matching the new filter also matches the old one when the
+	// filter was merely extended, e.g. while typing into the search box.
+	bool narrowing = !_filter.empty() && filt.hasPrefix(_filter);
+
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -686,27 +729,25 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 		// Restrict the list to everything which contains all words in _filter
 		// as substrings, ignoring case.
 
-		Common::StringTokenizer tok(_filter);
-		String tmp;
-		int n = 0;
+		StringArray tokens;
+		getFilterTokens(tokens);
+		updateSearchIndex();
+
+		// When narrowing, only the entries matching the old filter need to
+		// be checked again.
+		Common::Array<int> candidates;
+		if (narrowing)
+			candidates = _listIndex;
+
+		const uint count = narrowing ? candidates.size() : _dataList.size();
 
 		_list.clear();
 		_listIndex.clear();
 
-		for (StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
-			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!tmp.contains(tok.nextToken())) {
-					matches = false;
-					break;
-				}
-			}
-
-			if (matches) {
-				_list.push_back(*i);
+		for (uint i = 0; i < count; ++i) {
+			const int n = narrowing ? candidates[i] : (int)i;
+			if (matchesFilter(n, tokens)) {
+				_list.push_back(_dataList[n]);
 				_listIndex.push_back(n);
 			}
 		}
@@ -716,12 +757,20 @@ void ListWidget::setFilter(const String &filter, bool redraw) {
 	_selectedItem = -1;
 
 	if (redraw) {
+		bool scrollBarVisible = _scrollBar->isVisible();
 		scrollBarRecalc();
-		// Redraw the whole dialog. This is annoying, as this might be rather
-		// expensive when really only the list widget and its scroll bar area
-		// to be redrawn. However, since the scrollbar might change its
-		// visibility status, and the list its width, we cannot just redraw
-		// the two.
+
+		if (_scrollBar->isVisible() == scrollBarVisible) {
+			// Only the entries have changed, so redrawing the list and its
+			// scroll bar is enough. This keeps typing into the launcher's
+			// search box fast even with huge game lists.
+			markAsDirty();
+			return;
+		}
+
+		// The scroll bar has been shown or hidden, and its background is
+		// cached along with the rest of the dialog, so redraw the whole
+		// dialog.
 		// TODO: A more efficient (and elegant?) way to handle this would be to
 		// introduce a kind of "BoxWidget" or "GroupWidget" which defines a
 		// rectangular region and subwidgets can be placed within it.
@@ -57,6 +57,7 @@ protected:
 	StringArray		_dataList;
 	ColorList		_listColors;
 	Common::Array<int>		_listIndex;
+	StringArray		_searchIndex;	///< Lowercase copies of the _dataList entries, built on first use
 	bool			_editable;
 	bool			_editMode;
 	NumberingMode	_numberingMode;
@@ -139,6 +140,11 @@ protected:
 	/// Finds the item at position (x,y). Returns -1 if there is no item there.
 	int findItem(int x, int y) const;
 	void scrollBarRecalc();
+	void updateSearchIndex();
+	/// Splits _filter into the words an entry has to contain.
+	void getFilterTokens(StringArray &tokens) const;
+	/// Checks whether the data list entry n contains all tokens. Needs an up to date search index.
+	bool matchesFilter(int n, const StringArray &tokens) const;
 
 	void abortEditMode();
 
@@ -58,217 +58,163 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 }
 
 /**
- * Put a raw pixel to the destination surface
+ * Put two horizontally adjacent pixels of the same color
  */
 template<typename PixelInt>
-inline void putPixelRaw(PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = convertYUVToColor(clipTable, format, y, u, v);
+inline void putPixelPair(PixelInt *dst, uint32 color) {
+	dst[0] = dst[1] = (PixelInt)color;
 }
 
 /**
- * Specialized putPixelRaw for palettized 8bpp output
+ * Specialized putPixelPair for 8bpp output: both pixels are written at once
  */
 template<>
-inline void putPixelRaw(byte *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = y;
+inline void putPixelPair(byte *dst, uint32 color) {
+	WRITE_UINT16(dst, color * 0x0101);
+}
+
+/**
+ * Specialized putPixelPair for 16bpp output: both pixels are written at once
+ */
+template<>
+inline void putPixelPair(uint16 *dst, uint32 color) {
+	WRITE_UINT32(dst, color | (color << 16));
+}
+
+/**
+ * Put a 2x2 block of precomputed codebook colors
+ */
+template<typename PixelInt>
+inline void putBlock2x2(PixelInt *dst0, PixelInt *dst1, const CinepakCodebook &codebook) {
+	dst0[0] = (PixelInt)codebook.color[0];
+	dst0[1] = (PixelInt)codebook.color[1];
+	dst1[0] = (PixelInt)codebook.color[2];
+	dst1[1] = (PixelInt)codebook.color[3];
 }
 
 /**
  * The default codebook converter: raw output.
+ *
+ * The codebooks have already been converted to the output pixel
+ * format when they were loaded, so this only copies pixels.
  */
 struct CodebookConverterRaw {
 	template<typename PixelInt>
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4]) {
 		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
+		putPixelPair(rows[0] + 0, codebook.color[0]);
+		putPixelPair(rows[1] + 0, codebook.color[0]);
+		putPixelPair(rows[0] + 2, codebook.color[1]);
+		putPixelPair(rows[1] + 2, codebook.color[1]);
+		putPixelPair(rows[2] + 0, codebook.color[2]);
+		putPixelPair(rows[3] + 0, codebook.color[2]);
+		putPixelPair(rows[2] + 2, codebook.color[3]);
+		putPixelPair(rows[3] + 2, codebook.color[3]);
 	}
 
 	template<typename PixelInt>
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-
-		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
-
-		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-
-		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4]) {
+		putBlock2x2(rows[0] + 0, rows[1] + 0, strip.v4_codebook[codebookIndex[0]]);
+		putBlock2x2(rows[0] + 2, rows[1] + 2, strip.v4_codebook[codebookIndex[1]]);
+		putBlock2x2(rows[2] + 0, rows[3] + 0, strip.v4_codebook[codebookIndex[2]]);
+		putBlock2x2(rows[2] + 2, rows[3] + 2, strip.v4_codebook[codebookIndex[3]]);
 	}
 };
 
+inline byte getRGBLookupEntry(const byte *colorMap, uint16 index) {
+	return colorMap[s_defaultPaletteLookup[CLIP<int>(index, 0, 1023)]];
+}
+
 /**
- * Codebook converter that dithers in VFW-style
+ * Dither a v4 codebook entry in VFW-style into a 4x4 block
  */
-struct CodebookConverterDitherVFW {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		byte blockBuffer[16];
-		ditherCodebookSmooth(codebook, blockBuffer, colorMap);
-		rows[0][0] = blockBuffer[0];
-		rows[0][1] = blockBuffer[1];
-		rows[0][2] = blockBuffer[2];
-		rows[0][3] = blockBuffer[3];
-		rows[1][0] = blockBuffer[4];
-		rows[1][1] = blockBuffer[5];
-		rows[1][2] = blockBuffer[6];
-		rows[1][3] = blockBuffer[7];
-		rows[2][0] = blockBuffer[8];
-		rows[2][1] = blockBuffer[9];
-		rows[2][2] = blockBuffer[10];
-		rows[2][3] = blockBuffer[11];
-		rows[3][0] = blockBuffer[12];
-		rows[3][1] = blockBuffer[13];
-		rows[3][2] = blockBuffer[14];
-		rows[3][3] = blockBuffer[15];
-	}
-
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		byte blockBuffer[16];
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[0]], blockBuffer, colorMap);
-		rows[0][0] = blockBuffer[0];
-		rows[0][1] = blockBuffer[1];
-		rows[1][0] = blockBuffer[4];
-		rows[1][1] = blockBuffer[5];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[1]], blockBuffer, colorMap);
-		rows[0][2] = blockBuffer[2];
-		rows[0][3] = blockBuffer[3];
-		rows[1][2] = blockBuffer[6];
-		rows[1][3] = blockBuffer[7];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[2]], blockBuffer, colorMap);
-		rows[2][0] = blockBuffer[8];
-		rows[2][1] = blockBuffer[9];
-		rows[3][0] = blockBuffer[12];
-		rows[3][1] = blockBuffer[13];
-
-		ditherCodebookDetail(strip.v4_codebook[codebookIndex[3]], blockBuffer, colorMap);
-		rows[2][2] = blockBuffer[10];
-		rows[2][3] = blockBuffer[11];
-		rows[3][2] = blockBuffer[14];
-		rows[3][3] = blockBuffer[15];
-	}
-
-private:
-	static inline void ditherCodebookDetail(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
-		int uLookup = (byte)codebook.u * 2;
-		int vLookup = (byte)codebook.v * 2;
-		uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
-		uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
-
-		int yLookup1 = codebook.y[0] * 2;
-		int yLookup2 = codebook.y[1] * 2;
-		int yLookup3 = codebook.y[2] * 2;
-		int yLookup4 = codebook.y[3] * 2;
-
-		uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
-		uint32 pixelGroup2 = uv2 | s_yLookup[yLookup2 + 1];
-		uint32 pixelGroup3 = uv1 | s_yLookup[yLookup3];
-		uint32 pixelGroup4 = uv1 | s_yLookup[yLookup4];
-		uint32 pixelGroup5 = uv1 | s_yLookup[yLookup1];
-		uint32 pixelGroup6 = uv1 | s_yLookup[yLookup2];
-		uint32 pixelGroup7 = uv2 | s_yLookup[yLookup3 + 1];
-		uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
-
-		dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
-		dst[1] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
-		dst[2] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
-		dst[3] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
-		dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
-		dst[5] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
-		dst[6] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
-		dst[7] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
-		dst[8] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
-		dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
-		dst[10] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
-		dst[11] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
-		dst[12] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
-		dst[13] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
-		dst[14] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
-		dst[15] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
-	}
-
-	static inline void ditherCodebookSmooth(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
-		int uLookup = (byte)codebook.u * 2;
-		int vLookup = (byte)codebook.v * 2;
-		uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
-		uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
-
-		int yLookup1 = codebook.y[0] * 2;
-		int yLookup2 = codebook.y[1] * 2;
-		int yLookup3 = codebook.y[2] * 2;
-		int yLookup4 = codebook.y[3] * 2;
-
-		uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
-		uint32 pixelGroup2 = uv1 | s_yLookup[yLookup2];
-		uint32 pixelGroup3 = uv1 | s_yLookup[yLookup1];
-		uint32 pixelGroup4 = uv2 | s_yLookup[yLookup2 + 1];
-		uint32 pixelGroup5 = uv2 | s_yLookup[yLookup3 + 1];
-		uint32 pixelGroup6 = uv1 | s_yLookup[yLookup3];
-		uint32 pixelGroup7 = uv1 | s_yLookup[yLookup4];
-		uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
-
-		dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
-		dst[1] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
-		dst[2] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
-		dst[3] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
-		dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
-		dst[5] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
-		dst[6] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
-		dst[7] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
-		dst[8] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
-		dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
-		dst[10] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
-		dst[11] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
-		dst[12] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
-		dst[13] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
-		dst[14] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
-		dst[15] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
-	}
+inline void ditherCodebookDetail(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
+	int uLookup = (byte)codebook.u * 2;
+	int vLookup = (byte)codebook.v * 2;
+	uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
+	uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
+
+	int yLookup1 = codebook.y[0] * 2;
+	int yLookup2 = codebook.y[1] * 2;
+	int yLookup3 = codebook.y[2] * 2;
+	int yLookup4 = codebook.y[3] * 2;
+
+	uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
+	uint32 pixelGroup2 = uv2 | s_yLookup[yLookup2 + 1];
+	uint32 pixelGroup3 = uv1 | s_yLookup[yLookup3];
+	uint32 pixelGroup4 = uv1 | s_yLookup[yLookup4];
+	uint32 pixelGroup5 = uv1 | s_yLookup[yLookup1];
+	uint32 pixelGroup6 = uv1 | s_yLookup[yLookup2];
+	uint32 pixelGroup7 = uv2 | s_yLookup[yLookup3 + 1];
+	uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
+
+	dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
+	dst[1] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
+	dst[2] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
+	dst[3] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
+	dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
+	dst[5] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
+	dst[6] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
+	dst[7] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
+	dst[8] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
+	dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
+	dst[10] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
+	dst[11] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
+	dst[12] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
+	dst[13] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
+	dst[14] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
+	dst[15] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
+}
 
-	static inline byte getRGBLookupEntry(const byte *colorMap, uint16 index) {
-		return colorMap[s_defaultPaletteLookup[CLIP<int>(index, 0, 1023)]];
-	}
-};
+/**
+ * Dither a v1 codebook entry in VFW-style into a 4x4 block
+ */
+inline void ditherCodebookSmooth(const CinepakCodebook &codebook, byte *dst, const byte *colorMap) {
+	int uLookup = (byte)codebook.u * 2;
+	int vLookup = (byte)codebook.v * 2;
+	uint32 uv1 = s_uLookup[uLookup] | s_vLookup[vLookup];
+	uint32 uv2 = s_uLookup[uLookup + 1] | s_vLookup[vLookup + 1];
+
+	int yLookup1 = codebook.y[0] * 2;
+	int yLookup2 = codebook.y[1] * 2;
+	int yLookup3 = codebook.y[2] * 2;
+	int yLookup4 = codebook.y[3] * 2;
+
+	uint32 pixelGroup1 = uv2 | s_yLookup[yLookup1 + 1];
+	uint32 pixelGroup2 = uv1 | s_yLookup[yLookup2];
+	uint32 pixelGroup3 = uv1 | s_yLookup[yLookup1];
+	uint32 pixelGroup4 = uv2 | s_yLookup[yLookup2 + 1];
+	uint32 pixelGroup5 = uv2 | s_yLookup[yLookup3 + 1];
+	uint32 pixelGroup6 = uv1 | s_yLookup[yLookup3];
+	uint32 pixelGroup7 = uv1 | s_yLookup[yLookup4];
+	uint32 pixelGroup8 = uv2 | s_yLookup[yLookup4 + 1];
+
+	dst[0] = getRGBLookupEntry(colorMap, pixelGroup1 & 0xFFFF);
+	dst[1] = getRGBLookupEntry(colorMap, pixelGroup1 >> 16);
+	dst[2] = getRGBLookupEntry(colorMap, pixelGroup2 & 0xFFFF);
+	dst[3] = getRGBLookupEntry(colorMap, pixelGroup2 >> 16);
+	dst[4] = getRGBLookupEntry(colorMap, pixelGroup3 & 0xFFFF);
+	dst[5] = getRGBLookupEntry(colorMap, pixelGroup3 >> 16);
+	dst[6] = getRGBLookupEntry(colorMap, pixelGroup4 & 0xFFFF);
+	dst[7] = getRGBLookupEntry(colorMap, pixelGroup4 >> 16);
+	dst[8] = getRGBLookupEntry(colorMap, pixelGroup5 >> 16);
+	dst[9] = getRGBLookupEntry(colorMap, pixelGroup6 & 0xFFFF);
+	dst[10] = getRGBLookupEntry(colorMap, pixelGroup7 >> 16);
+	dst[11] = getRGBLookupEntry(colorMap, pixelGroup8 & 0xFFFF);
+	dst[12] = getRGBLookupEntry(colorMap, pixelGroup6 >> 16);
+	dst[13] = getRGBLookupEntry(colorMap, pixelGroup5 & 0xFFFF);
+	dst[14] = getRGBLookupEntry(colorMap, pixelGroup8 >> 16);
+	dst[15] = getRGBLookupEntry(colorMap, pixelGroup7 & 0xFFFF);
+}
 
 /**
- * Codebook converter that dithers in QT-style
+ * Codebook converter that copies from the pre-dithered tables.
+ *
+ * Both the QT and the VFW dithering are done once per codebook entry
+ * when the codebook is loaded, in the same table layout.
  */
-struct CodebookConverterDitherQT {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+struct CodebookConverterDitherTable {
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *(&rows)[4]) {
 		const byte *colorPtr = strip.v1_dither + (codebookIndex << 2);
 		WRITE_UINT32(rows[0], READ_UINT32(colorPtr));
 		WRITE_UINT32(rows[1], READ_UINT32(colorPtr + 1024));
@@ -276,7 +222,7 @@ struct CodebookConverterDitherQT {
 		WRITE_UINT32(rows[3], READ_UINT32(colorPtr + 3072));
 	}
 
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *(&rows)[4]) {
 		const byte *colorPtr = strip.v4_dither + (codebookIndex[0] << 2);
 		WRITE_UINT16(rows[0] + 0, READ_UINT16(colorPtr + 0));
 		WRITE_UINT16(rows[1] + 0, READ_UINT16(colorPtr + 2));
@@ -296,7 +242,7 @@ struct CodebookConverterDitherQT {
 };
 
 template<typename PixelInt, typename CodebookConverter>
-void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *colorMap, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
+void decodeVectorsTmpl(CinepakFrame &frame, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	uint32 flag = 0, mask = 0;
 	PixelInt *iy[4];
 	int32 startPos = stream.pos();
@@ -331,14 +277,14 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, const byte *c
 
 					// Get the codebook
 					byte codebook = stream.readByte();
-					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], iy);
 				} else if (flag & mask) {
 					if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
 					byte codebook[4];
 					stream.read(codebook, 4);
-					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], iy, clipTable, colorMap, frame.surface->format);
+					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], iy);
 				}
 			}
 
@@ -533,9 +479,14 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Convert the codebook to the output format (or dither it) now,
+			// so that decoding the vectors only has to copy pixels
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else if (_ditherType == kDitherTypeVFW)
+				ditherCodebookVFW(strip, codebookType, i);
+			else
+				convertCodebook(codebook[i]);
 		}
 	}
 }
@@ -598,16 +549,68 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 	}
 }
 
+void CinepakDecoder::ditherCodebookVFW(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	// Store the dithered blocks in the same layout as the QuickTime tables
+	byte blockBuffer[16];
+
+	if (codebookType == 1) {
+		ditherCodebookSmooth(_curFrame.strips[strip].v1_codebook[codebookIndex], blockBuffer, _colorMap);
+		byte *output = _curFrame.strips[strip].v1_dither + (codebookIndex << 2);
+
+		for (int y = 0; y < 4; y++)
+			memcpy(output + (y << 10), blockBuffer + (y << 2), 4);
+	} else {
+		ditherCodebookDetail(_curFrame.strips[strip].v4_codebook[codebookIndex], blockBuffer, _colorMap);
+		byte *output = _curFrame.strips[strip].v4_dither + (codebookIndex << 2);
+
+		// Each 2x2 quadrant of the detail block has its own table
+		for (int q = 0; q < 4; q++) {
+			const byte *src = blockBuffer + ((q >> 1) << 3) + ((q & 1) << 1);
+			output[(q << 10) + 0] = src[0];
+			output[(q << 10) + 1] = src[1];
+			output[(q << 10) + 2] = src[4];
+			output[(q << 10) + 3] = src[5];
+		}
+	}
+}
+
+void CinepakDecoder::convertCodebook(CinepakCodebook &codebook) const {
+	const Graphics::PixelFormat &format = _curFrame.surface->format;
+
+	for (int i = 0; i < 4; i++) {
+		if (format.bytesPerPixel == 1)
+			codebook.color[i] = codebook.y[i];
+		else
+			codebook.color[i] = convertYUVToColor(_clipTable, format, codebook.y[i], codebook.u, codebook.v);
+	}
+}
+
 void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_curFrame.surface->format.bytesPerPixel == 1) {
-		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, stream, strip, chunkID, chunkSize);
 	}
 }
 
+bool CinepakDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (format == _pixelFormat)
+		return true;
+
+	// The codebooks are converted as they are loaded, so the format
+	// cannot be changed once decoding has started
+	if (_curFrame.surface || _bitsPerPixel == 8 || _ditherPalette)
+		return false;
+
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	_pixelFormat = format;
+	return true;
+}
+
 bool CinepakDecoder::canDither(DitherType type) const {
 	return (type == kDitherTypeVFW || type == kDitherTypeQT) && _bitsPerPixel == 24;
 }
@@ -672,10 +675,7 @@ byte CinepakDecoder::findNearestRGB(int index) const {
 }
 
 void CinepakDecoder::ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
-	if (_ditherType == kDitherTypeVFW)
-		decodeVectorsTmpl<byte, CodebookConverterDitherVFW>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
-	else
-		decodeVectorsTmpl<byte, CodebookConverterDitherQT>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+	decodeVectorsTmpl<byte, CodebookConverterDitherTable>(_curFrame, stream, strip, chunkID, chunkSize);
 }
 
 } // End of namespace Image
@@ -39,6 +39,9 @@ struct CinepakCodebook {
 	// These are not in the normal YUV colorspace, but in the Cinepak YUV colorspace instead.
 	byte y[4]; // [0, 255]
 	int8 u, v; // [-128, 127]
+
+	// The four pixels converted to the output pixel format
+	uint32 color[4];
 };
 
 struct CinepakStrip {
@@ -46,6 +49,8 @@ struct CinepakStrip {
 	uint16 length;
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
+
+	// Codebooks pre-dithered to the palette, used for 8bpp output
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
 };
 
@@ -75,6 +80,7 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
 	Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
 	bool containsPalette() const { return _ditherPalette != 0; }
 	const byte *getPalette() { _dirtyPalette = false; return _ditherPalette; }
@@ -96,10 +102,12 @@ private:
 
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
+	void convertCodebook(CinepakCodebook &codebook) const;
 
 	byte findNearestRGB(int index) const;
 	void ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex);
+	void ditherCodebookVFW(uint16 strip, byte codebookType, uint16 codebookIndex);
 };
 
 } // End of namespace Image
@@ -86,6 +86,15 @@ public:
 	 */
 	virtual Graphics::PixelFormat getPixelFormat() const = 0;
 
+	/**
+	 * Select the format the decoded frames should be in, for codecs
+	 * which can decode straight into it. This avoids having to convert
+	 * every frame afterwards.
+	 *
+	 * @return true if the codec will now output in the given format
+	 */
+	virtual bool setOutputPixelFormat(const Graphics::PixelFormat &format) { return format == getPixelFormat(); }
+
 	/**
 	 * Can this codec's frames contain a palette?
 	 */
@@ -437,6 +437,9 @@ void AVFrame::freeFrame() {
 
 /*------------------------------------------------------------------------*/
 
+IVIStaticVLCTables *IVI45DecContext::_staticVlcTabs = nullptr;
+int IVI45DecContext::_staticVlcRefCount = 0;
+
 IVI45DecContext::IVI45DecContext() : _gb(nullptr), _frameNum(0), _frameType(0),
 		_prevFrameType(0), _dataSize(0), _isScalable(0), _frameData(0),
 		_interScal(0), _frameSize(0), _picHdrSize(0), _frameFlags(0),
@@ -449,16 +452,34 @@ IVI45DecContext::IVI45DecContext() : _gb(nullptr), _frameNum(0), _frameType(0),
 	Common::fill(&_bufInvalid[0], &_bufInvalid[4], 0);
 	Common::copy(&_ff_ivi_rvmap_tabs[0], &_ff_ivi_rvmap_tabs[9], &_rvmapTabs[0]);
 
+	if (!_staticVlcTabs)
+		_staticVlcTabs = new IVIStaticVLCTables();
+	_staticVlcRefCount++;
+
+	_iviMbVlcTabs = _staticVlcTabs->_mbVlcTabs;
+	_iviBlkVlcTabs = _staticVlcTabs->_blkVlcTabs;
+}
+
+IVI45DecContext::~IVI45DecContext() {
+	if (--_staticVlcRefCount == 0) {
+		delete _staticVlcTabs;
+		_staticVlcTabs = nullptr;
+	}
+}
+
+/*------------------------------------------------------------------------*/
+
+IVIStaticVLCTables::IVIStaticVLCTables() {
 	for (int idx = 0; idx < (8192 * 16); ++idx)
 		_tableData[idx][0] = _tableData[idx][1] = 0;
 
 	for (int i = 0; i < 8; i++) {
-		_iviMbVlcTabs[i]._table = _tableData + i * 2 * 8192;
-		_iviMbVlcTabs[i]._tableAllocated = 8192;
-		ivi_mb_huff_desc[i].createHuffFromDesc(&_iviMbVlcTabs[i], true);
-		_iviBlkVlcTabs[i]._table = _tableData + (i * 2 + 1) * 8192;
-		_iviBlkVlcTabs[i]._tableAllocated = 8192;
-		ivi_blk_huff_desc[i].createHuffFromDesc(&_iviBlkVlcTabs[i], true);
+		_mbVlcTabs[i]._table = _tableData + i * 2 * 8192;
+		_mbVlcTabs[i]._tableAllocated = 8192;
+		ivi_mb_huff_desc[i].createHuffFromDesc(&_mbVlcTabs[i], true);
+		_blkVlcTabs[i]._table = _tableData + (i * 2 + 1) * 8192;
+		_blkVlcTabs[i]._tableAllocated = 8192;
+		ivi_blk_huff_desc[i].createHuffFromDesc(&_blkVlcTabs[i], true);
 	}
 }
 
@@ -365,12 +365,26 @@ struct AVFrame {
 	void freeFrame();
 };
 
+/**
+ * The predefined Huffman tables. These never change, so they are only
+ * built once and shared between all decoder instances.
+ */
+struct IVIStaticVLCTables {
+	VLC_TYPE _tableData[8192 * 16][2];
+	VLC _mbVlcTabs[8];				///< static macroblock Huffman tables
+	VLC _blkVlcTabs[8];				///< static block Huffman tables
+
+	IVIStaticVLCTables();
+};
+
 struct IVI45DecContext {
 	friend struct IVIHuffTab;
 private:
-	VLC_TYPE _tableData[8192 * 16][2];
-	VLC _iviMbVlcTabs[8];			///< static macroblock Huffman tables
-	VLC _iviBlkVlcTabs[8];			///< static block Huffman tables
+	static IVIStaticVLCTables *_staticVlcTabs;
+	static int _staticVlcRefCount;
+
+	VLC *_iviMbVlcTabs;				///< static macroblock Huffman tables
+	VLC *_iviBlkVlcTabs;			///< static block Huffman tables
 public:
 	GetBits *		_gb;
 	RVMapDesc		_rvmapTabs[9];	///< local corrected copy of the static rvmap tables
@@ -426,6 +440,7 @@ public:
 	bool			_gotPFrame;
 
 	IVI45DecContext();
+	~IVI45DecContext();
 private:
 	/**
 	 *  Initial Run-value (RLE) tables.
@@ -28,9 +28,344 @@
 
 #include "image/codecs/indeo/indeo_dsp.h"
 
+// INDEO_DSP_NO_SSE2 leaves out the SSE2 versions, see test/image/indeo_dsp.h
+#if defined(__SSE2__) && !defined(INDEO_DSP_NO_SSE2)
+#define USE_SSE2_INDEO
+#include <emmintrin.h>
+#endif
+
 namespace Image {
 namespace Indeo {
 
+#ifdef USE_SSE2_INDEO
+/*
+ * SSE2 versions of the 8x8 inverse transforms and motion compensation.
+ * The transforms handle four columns (or rows) of 32 bit coefficients
+ * per vector and, like the scalar int arithmetic, wrap around on
+ * overflow. They produce exactly the same output as the scalar code,
+ * including the truncation of the results to int16.
+ */
+namespace {
+
+/**
+ * Truncate the 32 bit lanes of lo and hi to 16 bits, the same way the
+ * scalar code does when it stores an int into an int16.
+ */
+inline __m128i narrowTruncate(__m128i lo, __m128i hi) {
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/**
+ * Sign extend the lower four 16 bit lanes of v to 32 bits.
+ */
+inline __m128i widenLo(__m128i v) {
+	return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+/**
+ * Sign extend the upper four 16 bit lanes of v to 32 bits.
+ */
+inline __m128i widenHi(__m128i v) {
+	return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+inline void transpose4x4(__m128i &r0, __m128i &r1, __m128i &r2, __m128i &r3) {
+	const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+	const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+	const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+	const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+	r0 = _mm_unpacklo_epi64(t0, t1);
+	r1 = _mm_unpackhi_epi64(t0, t1);
+	r2 = _mm_unpacklo_epi64(t2, t3);
+	r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Return a mask of the lanes whose column flag is cleared. The scalar
+ * column passes output zeros for these columns.
+ */
+inline __m128i emptyColumns(const uint8 *flags) {
+	return _mm_cmpeq_epi32(_mm_set_epi32(flags[3], flags[2], flags[1], flags[0]), _mm_setzero_si128());
+}
+
+/**
+ * Load four columns of an 8x8 coefficient block, one vector per row.
+ */
+inline void loadColumns(const int32 *in, __m128i *s) {
+	for (int k = 0; k < 8; k++)
+		s[k] = _mm_loadu_si128((const __m128i *)(in + k * 8));
+}
+
+/**
+ * Load four rows of an 8x8 coefficient block, one vector per column.
+ */
+inline void loadRows(const int32 *in, __m128i *s) {
+	for (int k = 0; k < 8; k += 4) {
+		s[k + 0] = _mm_loadu_si128((const __m128i *)(in +  0 + k));
+		s[k + 1] = _mm_loadu_si128((const __m128i *)(in +  8 + k));
+		s[k + 2] = _mm_loadu_si128((const __m128i *)(in + 16 + k));
+		s[k + 3] = _mm_loadu_si128((const __m128i *)(in + 24 + k));
+		transpose4x4(s[k + 0], s[k + 1], s[k + 2], s[k + 3]);
+	}
+}
+
+/**
+ * Store four columns of output pixels, given one vector per row.
+ */
+inline void storeColumns(const __m128i *d, int16 *out, uint32 pitch) {
+	for (int k = 0; k < 8; k++, out += pitch)
+		_mm_storel_epi64((__m128i *)out, narrowTruncate(d[k], d[k]));
+}
+
+/**
+ * Store four rows of output pixels, given one vector per column.
+ */
+inline void storeRows(__m128i *d, int16 *out, uint32 pitch) {
+	transpose4x4(d[0], d[1], d[2], d[3]);
+	transpose4x4(d[4], d[5], d[6], d[7]);
+	for (int k = 0; k < 4; k++, out += pitch)
+		_mm_storeu_si128((__m128i *)out, narrowTruncate(d[k], d[k + 4]));
+}
+
+#define IVI_HAAR_BFLY_SSE2(s1, s2, o1, o2, t) \
+	t  = _mm_srai_epi32(_mm_sub_epi32(s1, s2), 1);\
+	o1 = _mm_srai_epi32(_mm_add_epi32(s1, s2), 1);\
+	o2 = (t);
+
+#define IVI_SLANT_BFLY_SSE2(s1, s2, o1, o2, t) \
+	t  = _mm_sub_epi32(s1, s2);\
+	o1 = _mm_add_epi32(s1, s2);\
+	o2 = (t);
+
+#define IVI_IREFLECT_SSE2(s1, s2, o1, o2, t) \
+	t  = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(s1, _mm_slli_epi32(s2, 1)), two), 2), s1);\
+	o2 = _mm_sub_epi32(_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s1, 1), s2), two), 2), s2);\
+	o1 = (t);
+
+#define IVI_SLANT_PART4_SSE2(s1, s2, o1, o2, t) \
+	t  = _mm_add_epi32(s2, _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(s1, 2), s2), four), 3));\
+	o2 = _mm_add_epi32(s1, _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(four, s1), _mm_slli_epi32(s2, 2)), 3));\
+	o1 = (t);
+
+/**
+ * INV_HAAR8 on four lanes at once. s holds the inputs in the order of
+ * the INV_HAAR8 arguments, d receives the eight outputs.
+ */
+inline void invHaar8(const __m128i *s, __m128i *d) {
+	__m128i t0, t1, t2, t3, t4, t5, t6, t7, t8;
+
+	t1 = _mm_slli_epi32(s[0], 1);
+	t5 = _mm_slli_epi32(s[1], 1);
+	IVI_HAAR_BFLY_SSE2(t1, t5, t1, t5, t0); IVI_HAAR_BFLY_SSE2(t1, s[2], t1, t3, t0);
+	IVI_HAAR_BFLY_SSE2(t5, s[3], t5, t7, t0); IVI_HAAR_BFLY_SSE2(t1, s[4], t1, t2, t0);
+	IVI_HAAR_BFLY_SSE2(t3, s[5], t3, t4, t0); IVI_HAAR_BFLY_SSE2(t5, s[6], t5, t6, t0);
+	IVI_HAAR_BFLY_SSE2(t7, s[7], t7, t8, t0);
+	d[0] = t1; d[1] = t2; d[2] = t3; d[3] = t4;
+	d[4] = t5; d[5] = t6; d[6] = t7; d[7] = t8;
+}
+
+/**
+ * IVI_INV_SLANT8 on four lanes at once. s holds the inputs in the order
+ * of the IVI_INV_SLANT8 arguments, d receives the eight outputs. When
+ * compensate is set, the outputs are rounded and halved like in the
+ * second pass of the scalar code.
+ */
+inline void invSlant8(const __m128i *s, __m128i *d, bool compensate) {
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128i four = _mm_set1_epi32(4);
+	__m128i t0, t1, t2, t3, t4, t5, t6, t7, t8;
+
+	IVI_SLANT_PART4_SSE2(s[1], s[3], t4, t5, t0);
+
+	IVI_SLANT_BFLY_SSE2(s[0], t5, t1, t5, t0); IVI_SLANT_BFLY_SSE2(s[4], s[5], t2, t6, t0);
+	IVI_SLANT_BFLY_SSE2(s[7], s[6], t7, t3, t0); IVI_SLANT_BFLY_SSE2(t4, s[2], t4, t8, t0);
+
+	IVI_SLANT_BFLY_SSE2(t1, t2, t1, t2, t0); IVI_IREFLECT_SSE2(t4, t3, t4, t3, t0);
+	IVI_SLANT_BFLY_SSE2(t5, t6, t5, t6, t0); IVI_IREFLECT_SSE2(t8, t7, t8, t7, t0);
+	IVI_SLANT_BFLY_SSE2(t1, t4, t1, t4, t0); IVI_SLANT_BFLY_SSE2(t2, t3, t2, t3, t0);
+	IVI_SLANT_BFLY_SSE2(t5, t8, t5, t8, t0); IVI_SLANT_BFLY_SSE2(t6, t7, t6, t7, t0);
+	d[0] = t1; d[1] = t2; d[2] = t3; d[3] = t4;
+	d[4] = t5; d[5] = t6; d[6] = t7; d[7] = t8;
+
+	if (compensate) {
+		for (int k = 0; k < 8; k++)
+			d[k] = _mm_srai_epi32(_mm_add_epi32(d[k], one), 1);
+	}
+}
+
+#undef IVI_HAAR_BFLY_SSE2
+#undef IVI_SLANT_BFLY_SSE2
+#undef IVI_IREFLECT_SSE2
+#undef IVI_SLANT_PART4_SSE2
+
+// Rows and columns without any non-zero coefficient transform to zeros,
+// so unlike the scalar code the SSE2 versions do not need to skip them.
+
+void inverseHaar8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	int32 tmp[64];
+	__m128i s[8], d[8];
+
+	for (int x = 0; x < 8; x += 4) {
+		const __m128i empty = emptyColumns(flags + x);
+		loadColumns(in + x, s);
+		// pre-scaling of the left half
+		if (x == 0) {
+			for (int k = 0; k < 4; k++)
+				s[k] = _mm_slli_epi32(s[k], 1);
+		}
+		invHaar8(s, d);
+		for (int k = 0; k < 8; k++)
+			_mm_storeu_si128((__m128i *)(tmp + k * 8 + x), _mm_andnot_si128(empty, d[k]));
+	}
+
+	for (int y = 0; y < 8; y += 4) {
+		loadRows(tmp + y * 8, s);
+		invHaar8(s, d);
+		storeRows(d, out + y * pitch, pitch);
+	}
+}
+
+void rowHaar8SSE2(const int32 *in, int16 *out, uint32 pitch) {
+	__m128i s[8], d[8];
+
+	for (int y = 0; y < 8; y += 4) {
+		loadRows(in + y * 8, s);
+		invHaar8(s, d);
+		storeRows(d, out + y * pitch, pitch);
+	}
+}
+
+void colHaar8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i s[8], d[8];
+
+	for (int x = 0; x < 8; x += 4) {
+		const __m128i empty = emptyColumns(flags + x);
+		loadColumns(in + x, s);
+		invHaar8(s, d);
+		for (int k = 0; k < 8; k++)
+			d[k] = _mm_andnot_si128(empty, d[k]);
+		storeColumns(d, out + x, pitch);
+	}
+}
+
+void inverseSlant8x8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	int32 tmp[64];
+	__m128i s[8], d[8];
+
+	for (int x = 0; x < 8; x += 4) {
+		const __m128i empty = emptyColumns(flags + x);
+		loadColumns(in + x, s);
+		invSlant8(s, d, false);
+		for (int k = 0; k < 8; k++)
+			_mm_storeu_si128((__m128i *)(tmp + k * 8 + x), _mm_andnot_si128(empty, d[k]));
+	}
+
+	for (int y = 0; y < 8; y += 4) {
+		loadRows(tmp + y * 8, s);
+		invSlant8(s, d, true);
+		storeRows(d, out + y * pitch, pitch);
+	}
+}
+
+void rowSlant8SSE2(const int32 *in, int16 *out, uint32 pitch) {
+	__m128i s[8], d[8];
+
+	for (int y = 0; y < 8; y += 4) {
+		loadRows(in + y * 8, s);
+		invSlant8(s, d, true);
+		storeRows(d, out + y * pitch, pitch);
+	}
+}
+
+void colSlant8SSE2(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	__m128i s[8], d[8];
+
+	for (int x = 0; x < 8; x += 4) {
+		const __m128i empty = emptyColumns(flags + x);
+		loadColumns(in + x, s);
+		invSlant8(s, d, true);
+		for (int k = 0; k < 8; k++)
+			d[k] = _mm_andnot_si128(empty, d[k]);
+		storeColumns(d, out + x, pitch);
+	}
+}
+
+void putPixels8x8SSE2(const int32 *in, int16 *out, uint32 pitch) {
+	for (int y = 0; y < 8; out += pitch, in += 8, y++) {
+		const __m128i lo = _mm_loadu_si128((const __m128i *)in);
+		const __m128i hi = _mm_loadu_si128((const __m128i *)(in + 4));
+		_mm_storeu_si128((__m128i *)out, narrowTruncate(lo, hi));
+	}
+}
+
+/**
+ * Average two rows of eight pixels, rounding down. The sum is computed
+ * in 32 bits like in the scalar code, so the result always fits.
+ */
+inline __m128i average2(__m128i a, __m128i b) {
+	const __m128i lo = _mm_srai_epi32(_mm_add_epi32(widenLo(a), widenLo(b)), 1);
+	const __m128i hi = _mm_srai_epi32(_mm_add_epi32(widenHi(a), widenHi(b)), 1);
+	return _mm_packs_epi32(lo, hi);
+}
+
+/**
+ * Average four rows of eight pixels, rounding down.
+ */
+inline __m128i average4(__m128i a, __m128i b, __m128i c, __m128i d) {
+	const __m128i lo = _mm_add_epi32(_mm_add_epi32(widenLo(a), widenLo(b)), _mm_add_epi32(widenLo(c), widenLo(d)));
+	const __m128i hi = _mm_add_epi32(_mm_add_epi32(widenHi(a), widenHi(b)), _mm_add_epi32(widenHi(c), widenHi(d)));
+	return _mm_packs_epi32(_mm_srai_epi32(lo, 2), _mm_srai_epi32(hi, 2));
+}
+
+/**
+ * Store or, for delta blocks, add a row of eight pixels to buf.
+ */
+inline void storeMc8(int16 *buf, __m128i px, bool isDelta) {
+	if (isDelta)
+		px = _mm_add_epi16(_mm_loadu_si128((const __m128i *)buf), px);
+	_mm_storeu_si128((__m128i *)buf, px);
+}
+
+void mc8x8SSE2(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType, bool isDelta) {
+	if (mcType < 0 || mcType > 3)
+		return;
+
+	for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch) {
+		const __m128i a = _mm_loadu_si128((const __m128i *)refBuf);
+		__m128i px;
+
+		switch (mcType) {
+		case 0: // fullpel (no interpolation)
+			px = a;
+			break;
+		case 1: // horizontal halfpel interpolation
+			px = average2(a, _mm_loadu_si128((const __m128i *)(refBuf + 1)));
+			break;
+		case 2: // vertical halfpel interpolation
+			px = average2(a, _mm_loadu_si128((const __m128i *)(refBuf + pitch)));
+			break;
+		default: // vertical and horizontal halfpel interpolation
+			px = average4(a, _mm_loadu_si128((const __m128i *)(refBuf + 1)),
+				_mm_loadu_si128((const __m128i *)(refBuf + pitch)),
+				_mm_loadu_si128((const __m128i *)(refBuf + pitch + 1)));
+			break;
+		}
+
+		storeMc8(buf, px, isDelta);
+	}
+}
+
+void mcAvg8x8SSE2(int16 *buf, const int16 *tmp, uint32 pitch, bool isDelta) {
+	for (int i = 0; i < 8; i++, buf += pitch, tmp += 8)
+		storeMc8(buf, _mm_srai_epi16(_mm_loadu_si128((const __m128i *)tmp), 1), isDelta);
+}
+
+} // End of anonymous namespace
+#endif
+
 /**
  * butterfly operation for the inverse Haar transform
  */
@@ -73,6 +408,9 @@ namespace Indeo {
 
 void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 							 const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	inverseHaar8x8SSE2(in, out, pitch, flags);
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -121,10 +459,14 @@ void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
 					  const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	rowHaar8SSE2(in, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	// apply the InvHaar8 to all rows
@@ -144,10 +486,14 @@ void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviColHaar8(const int32 *in, int16 *out, uint32 pitch,
 					  const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	colHaar8SSE2(in, out, pitch, flags);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	// apply the InvHaar8 to all columns
@@ -172,6 +518,7 @@ void IndeoDSP::ffIviColHaar8(const int32 *in, int16 *out, uint32 pitch,
 		out++;
 	}
 #undef  COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviInverseHaar4x4(const int32 *in, int16 *out, uint32 pitch,
@@ -322,6 +669,9 @@ void IndeoDSP::ffIviDcHaar2d(const int32 *in, int16 *out, uint32 pitch,
 	d4 = COMPENSATE(t4);}
 
 void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	inverseSlant8x8SSE2(in, out, pitch, flags);
+#else
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -356,6 +706,7 @@ void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, c
 		out += pitch;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviInverseSlant4x4(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
@@ -406,6 +757,9 @@ void IndeoDSP::ffIviDcSlant2d(const int32 *in, int16 *out, uint32 pitch,
 
 void IndeoDSP::ffIviRowSlant8(const int32 *in, int16 *out, uint32 pitch,
 		const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	rowSlant8SSE2(in, out, pitch);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 #define COMPENSATE(x) (((x) + 1)>>1)
@@ -421,6 +775,7 @@ void IndeoDSP::ffIviRowSlant8(const int32 *in, int16 *out, uint32 pitch,
 		out += pitch;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviDcRowSlant(const int32 *in, int16 *out, uint32 pitch, int blkSize) {
@@ -438,6 +793,9 @@ void IndeoDSP::ffIviDcRowSlant(const int32 *in, int16 *out, uint32 pitch, int bl
 }
 
 void IndeoDSP::ffIviColSlant8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	colSlant8SSE2(in, out, pitch, flags);
+#else
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
 	int row2 = pitch << 1;
@@ -460,6 +818,7 @@ void IndeoDSP::ffIviColSlant8(const int32 *in, int16 *out, uint32 pitch, const u
 		out++;
 	}
 #undef COMPENSATE
+#endif
 }
 
 void IndeoDSP::ffIviDcColSlant(const int32 *in, int16 *out, uint32 pitch, int blkSize) {
@@ -515,9 +874,13 @@ void IndeoDSP::ffIviColSlant4(const int32 *in, int16 *out, uint32 pitch,
 
 void IndeoDSP::ffIviPutPixels8x8(const int32 *in, int16 *out, uint32 pitch,
 		const uint8 *flags) {
+#ifdef USE_SSE2_INDEO
+	putPixels8x8SSE2(in, out, pitch);
+#else
 	for (int y = 0; y < 8; out += pitch, in += 8, y++)
 		for (int x = 0; x < 8; x++)
 			out[x] = in[x];
+#endif
 }
 
 void IndeoDSP::ffIviPutDcPixel8x8(const int32 *in, int16 *out, uint32 pitch,
@@ -530,13 +893,31 @@ void IndeoDSP::ffIviPutDcPixel8x8(const int32 *in, int16 *out, uint32 pitch,
 		memset(out, 0, 8 * sizeof(out[0]));
 }
 
-#define IVI_MC_TEMPLATE(size, suffix, OP) \
+#ifdef USE_SSE2_INDEO
+#define IVI_MC_SSE2(size, isDelta) \
+	if (size == 8) { \
+		mc8x8SSE2(buf, dpitch, refBuf, pitch, mcType, isDelta); \
+		return; \
+	}
+#define IVI_MC_AVG_SSE2(size, isDelta) \
+	if (size == 8) { \
+		mcAvg8x8SSE2(buf, tmp, pitch, isDelta); \
+		return; \
+	}
+#else
+#define IVI_MC_SSE2(size, isDelta)
+#define IVI_MC_AVG_SSE2(size, isDelta)
+#endif
+
+#define IVI_MC_TEMPLATE(size, suffix, OP, isDelta) \
 static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 												 uint32 dpitch, \
 												 const int16 *refBuf, \
 												 uint32 pitch, int mcType) \
 { \
 	const int16 *wptr; \
+\
+	IVI_MC_SSE2(size, isDelta) \
 \
 	switch (mcType) { \
 	case 0: /* fullpel (no interpolation) */ \
@@ -572,7 +953,7 @@ void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *ref
 	iviMc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
 }
 
-#define IVI_MC_AVG_TEMPLATE(size, suffix, OP) \
+#define IVI_MC_AVG_TEMPLATE(size, suffix, OP, isDelta) \
 void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 												 const int16 *refBuf, \
 												 const int16 *refBuf2, \
@@ -583,6 +964,7 @@ void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 \
 	iviMc ## size ##x## size ## NoDelta(tmp, size, refBuf, pitch, mcType); \
 	iviMc ## size ##x## size ## Delta(tmp, size, refBuf2, pitch, mcType2); \
+	IVI_MC_AVG_SSE2(size, isDelta) \
 	for (int i = 0; i < size; i++, buf += pitch) { \
 		for (int j = 0; j < size; j++) {\
 			OP(buf[j], tmp[i * size + j] >> 1); \
@@ -593,14 +975,14 @@ void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 #define OP_PUT(a, b)  (a) = (b)
 #define OP_ADD(a, b)  (a) += (b)
 
-IVI_MC_TEMPLATE(8, NoDelta, OP_PUT)
-IVI_MC_TEMPLATE(8, Delta,   OP_ADD)
-IVI_MC_TEMPLATE(4, NoDelta, OP_PUT)
-IVI_MC_TEMPLATE(4, Delta,   OP_ADD)
-IVI_MC_AVG_TEMPLATE(8, NoDelta, OP_PUT)
-IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
-IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
-IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
+IVI_MC_TEMPLATE(8, NoDelta, OP_PUT, false)
+IVI_MC_TEMPLATE(8, Delta,   OP_ADD, true)
+IVI_MC_TEMPLATE(4, NoDelta, OP_PUT, false)
+IVI_MC_TEMPLATE(4, Delta,   OP_ADD, true)
+IVI_MC_AVG_TEMPLATE(8, NoDelta, OP_PUT, false)
+IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD, true)
+IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT, false)
+IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD, true)
 
 } // End of namespace Indeo
 } // End of namespace Image
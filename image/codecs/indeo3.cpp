@@ -82,6 +82,22 @@ Graphics::PixelFormat Indeo3Decoder::getPixelFormat() const {
 	return _pixelFormat;
 }
 
+bool Indeo3Decoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	if (format != _pixelFormat) {
+		uint16 width = _surface->w;
+		uint16 height = _surface->h;
+
+		_pixelFormat = format;
+		_surface->free();
+		_surface->create(width, height, _pixelFormat);
+	}
+
+	return true;
+}
+
 bool Indeo3Decoder::isIndeo3(Common::SeekableReadStream &stream) {
 	// Less than 16 bytes? This can't be right
 	if (stream.size() < 16)
@@ -51,6 +51,7 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
 	Graphics::PixelFormat getPixelFormat() const;
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
 	static bool isIndeo3(Common::SeekableReadStream &stream);
 
@@ -28,6 +28,7 @@
 #include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "graphics/conversion.h"
 #include "graphics/surface.h"
 #include "image/jpeg.h"
 
@@ -42,6 +43,9 @@ namespace Image {
 MJPEGDecoder::MJPEGDecoder() : Codec() {
 	_pixelFormat = g_system->getScreenFormat();
 	_surface = 0;
+	_jpeg = new JPEGDecoder();
+	_data = 0;
+	_dataSize = 0;
 }
 
 MJPEGDecoder::~MJPEGDecoder() {
@@ -49,6 +53,17 @@ MJPEGDecoder::~MJPEGDecoder() {
 		_surface->free();
 		delete _surface;
 	}
+
+	delete _jpeg;
+	free(_data);
+}
+
+bool MJPEGDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	_pixelFormat = format;
+	return true;
 }
 
 // Header to be inserted
@@ -163,13 +178,22 @@ const Graphics::Surface *MJPEGDecoder::decodeFrame(Common::SeekableReadStream &s
 	}
 
 	uint32 outputSize = stream.size() - inputSkip + sizeof(s_jpegHeader) + DHT_SEGMENT_SIZE;
-	byte *data = (byte *)malloc(outputSize);
 
-	if (!data) {
-		warning("Failed to allocate data for MJPEG conversion");
-		return 0;
+	// Only grow the conversion buffer when a frame does not fit
+	if (outputSize > _dataSize) {
+		byte *data = (byte *)realloc(_data, outputSize);
+
+		if (!data) {
+			warning("Failed to allocate data for MJPEG conversion");
+			return 0;
+		}
+
+		_data = data;
+		_dataSize = outputSize;
 	}
 
+	byte *data = _data;
+
 	// Copy the header
 	memcpy(data, s_jpegHeader, sizeof(s_jpegHeader));
 	uint32 dataOffset = sizeof(s_jpegHeader);
@@ -198,20 +222,28 @@ const Graphics::Surface *MJPEGDecoder::decodeFrame(Common::SeekableReadStream &s
 	stream.seek(inputSkip);
 	stream.read(data + dataOffset, stream.size() - inputSkip);
 
-	Common::MemoryReadStream convertedStream(data, outputSize, DisposeAfterUse::YES);
-	JPEGDecoder jpeg;
+	Common::MemoryReadStream convertedStream(data, outputSize);
 
-	if (!jpeg.loadStream(convertedStream)) {
+	if (!_jpeg->loadStream(convertedStream)) {
 		warning("Failed to decode MJPEG frame");
 		return 0;
 	}
 
-	if (_surface) {
+	const Graphics::Surface *frame = _jpeg->getSurface();
+
+	// Convert into the same surface every frame, only (re)creating it
+	// when the frame size or the output format changes
+	if (!_surface) {
+		_surface = new Graphics::Surface();
+		_surface->create(frame->w, frame->h, _pixelFormat);
+	} else if (_surface->w != frame->w || _surface->h != frame->h || _surface->format != _pixelFormat) {
 		_surface->free();
-		delete _surface;
+		_surface->create(frame->w, frame->h, _pixelFormat);
 	}
 
-	_surface = jpeg.getSurface()->convertTo(_pixelFormat);
+	Graphics::crossBlit((byte *)_surface->getPixels(), (const byte *)frame->getPixels(),
+	                    _surface->pitch, frame->pitch, frame->w, frame->h,
+	                    _surface->format, frame->format);
 
 	return _surface;
 }
@@ -36,6 +36,8 @@ struct Surface;
 
 namespace Image {
 
+class JPEGDecoder;
+
 /**
  * Motion JPEG decoder.
  *
@@ -48,10 +50,16 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream);
 	Graphics::PixelFormat getPixelFormat() const { return _pixelFormat; }
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
 private:
 	Graphics::PixelFormat _pixelFormat;
 	Graphics::Surface *_surface;
+
+	// Kept between frames, so they don't have to be set up for every frame
+	JPEGDecoder *_jpeg;
+	byte *_data;
+	uint32 _dataSize;
 };
 
 } // End of namespace Image
@@ -44,11 +44,28 @@ extern "C" {
 
 namespace Image {
 
-JPEGDecoder::JPEGDecoder() : _surface(), _colorSpace(kColorSpaceRGBA) {
+#ifdef USE_JPEG
+struct JPEGDecoder::DecompressState {
+	jpeg_decompress_struct cinfo;
+	jpeg_error_mgr jerr;
+};
+#else
+struct JPEGDecoder::DecompressState {
+};
+#endif
+
+JPEGDecoder::JPEGDecoder() : _surface(), _colorSpace(kColorSpaceRGBA), _decompressState(0) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
 	destroy();
+
+#ifdef USE_JPEG
+	if (_decompressState)
+		jpeg_destroy_decompress(&_decompressState->cinfo);
+#endif
+
+	delete _decompressState;
 }
 
 const Graphics::Surface *JPEGDecoder::getSurface() const {
@@ -176,19 +193,19 @@ void outputMessage(j_common_ptr cinfo) {
 
 bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #ifdef USE_JPEG
-	// Reset member variables from previous decodings
-	destroy();
+	if (!_decompressState) {
+		_decompressState = new DecompressState();
 
-	jpeg_decompress_struct cinfo;
-	jpeg_error_mgr jerr;
+		// Initialize error handling callbacks
+		_decompressState->cinfo.err = jpeg_std_error(&_decompressState->jerr);
+		_decompressState->cinfo.err->error_exit = &errorExit;
+		_decompressState->cinfo.err->output_message = &outputMessage;
 
-	// Initialize error handling callbacks
-	cinfo.err = jpeg_std_error(&jerr);
-	cinfo.err->error_exit = &errorExit;
-	cinfo.err->output_message = &outputMessage;
+		// Initialize the decompression structure
+		jpeg_create_decompress(&_decompressState->cinfo);
+	}
 
-	// Initialize the decompression structure
-	jpeg_create_decompress(&cinfo);
+	jpeg_decompress_struct &cinfo = _decompressState->cinfo;
 
 	// Initialize our buffer handling
 	jpeg_scummvm_src(&cinfo, &stream);
@@ -211,19 +228,28 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	jpeg_start_decompress(&cinfo);
 
 	// Allocate buffers for the output data
+	Graphics::PixelFormat format;
 	switch (_colorSpace) {
 	case kColorSpaceRGBA:
 		// We use RGBA8888 in this scenario
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0));
+		format = Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0);
 		break;
 
 	case kColorSpaceYUV:
 		// We use YUV with 3 bytes per pixel otherwise.
 		// This is pretty ugly since our PixelFormat cannot express YUV...
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0));
+		format = Graphics::PixelFormat(3, 0, 0, 0, 0, 0, 0, 0, 0);
 		break;
 	}
 
+	// Reuse the surface from the previous decoding if it has the right
+	// size, which is the usual case when decoding video frames
+	if (!_surface.getPixels() || _surface.w != (int16)cinfo.output_width
+			|| _surface.h != (int16)cinfo.output_height || _surface.format != format) {
+		_surface.free();
+		_surface.create(cinfo.output_width, cinfo.output_height, format);
+	}
+
 	// Allocate buffer for one scanline
 	assert(cinfo.output_components == 3);
 	JDIMENSION pitch = cinfo.output_width * cinfo.output_components;
@@ -234,39 +260,38 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	while (cinfo.output_scanline < cinfo.output_height) {
 		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
 
+		if (_colorSpace == kColorSpaceYUV) {
+			// YUV data needs no conversion, so read it straight into the surface
+			JSAMPROW row = dst;
+			jpeg_read_scanlines(&cinfo, &row, 1);
+			continue;
+		}
+
 		jpeg_read_scanlines(&cinfo, buffer, 1);
 
 		const byte *src = buffer[0];
-		switch (_colorSpace) {
-		case kColorSpaceRGBA: {
-			for (int remaining = cinfo.output_width; remaining > 0; --remaining) {
-				byte r = *src++;
-				byte g = *src++;
-				byte b = *src++;
-				// We need to insert a alpha value of 255 (opaque) here.
+		for (int remaining = cinfo.output_width; remaining > 0; --remaining) {
+			byte r = *src++;
+			byte g = *src++;
+			byte b = *src++;
+			// We need to insert a alpha value of 255 (opaque) here.
 #ifdef SCUMM_BIG_ENDIAN
-				*dst++ = r;
-				*dst++ = g;
-				*dst++ = b;
-				*dst++ = 0xFF;
+			*dst++ = r;
+			*dst++ = g;
+			*dst++ = b;
+			*dst++ = 0xFF;
 #else
-				*dst++ = 0xFF;
-				*dst++ = b;
-				*dst++ = g;
-				*dst++ = r;
+			*dst++ = 0xFF;
+			*dst++ = b;
+			*dst++ = g;
+			*dst++ = r;
 #endif
-			}
-			} break;
-
-		case kColorSpaceYUV:
-			memcpy(dst, src, pitch);
-			break;
 		}
 	}
 
-	// We are done with decompressing, thus free all the data
+	// We are done with decompressing, thus free the per-image data. The
+	// decompression object itself is kept for the next image.
 	jpeg_finish_decompress(&cinfo);
-	jpeg_destroy_decompress(&cinfo);
 
 	return true;
 #else
@@ -93,8 +93,17 @@ public:
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
 private:
+	struct DecompressState;
+
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
+
+	/**
+	 * The libjpeg decompression state. This is kept around between
+	 * images, so that decoding multiple images (e.g. the frames of a
+	 * video) does not have to set it up again every time.
+	 */
+	DecompressState *_decompressState;
 };
 
 } // End of namespace Image
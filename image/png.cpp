@@ -31,6 +31,7 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -84,6 +85,28 @@ void pngFlushStream(png_structp pngPtr) {
 	Common::WriteStream *stream = (Common::WriteStream *)writeIOptr;
 	stream->flush();
 }
+
+// Set up the transformations to output 32bpp ARGB rows
+void setARGBTransforms(png_structp pngPtr, int bitDepth, int colorType) {
+	if (bitDepth == 16)
+		png_set_strip_16(pngPtr);
+	if (bitDepth < 8)
+		png_set_expand(pngPtr);
+	if (colorType == PNG_COLOR_TYPE_GRAY ||
+		colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
+		png_set_gray_to_rgb(pngPtr);
+
+	// PNGs are Big-Endian:
+#ifdef SCUMM_LITTLE_ENDIAN
+	png_set_bgr(pngPtr);
+	png_set_swap_alpha(pngPtr);
+	if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
+		png_set_filler(pngPtr, 0xff, PNG_FILLER_BEFORE);
+#else
+	if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
+		png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+#endif
+}
 #endif
 
 /*
@@ -176,25 +199,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		if (!_outputSurface->getPixels()) {
 			error("Could not allocate memory for output image.");
 		}
-		if (bitDepth == 16)
-			png_set_strip_16(pngPtr);
-		if (bitDepth < 8)
-			png_set_expand(pngPtr);
-		if (colorType == PNG_COLOR_TYPE_GRAY ||
-			colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
-			png_set_gray_to_rgb(pngPtr);
-
-		// PNGs are Big-Endian:
-#ifdef SCUMM_LITTLE_ENDIAN
-		png_set_bgr(pngPtr);
-		png_set_swap_alpha(pngPtr);
-		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
-			png_set_filler(pngPtr, 0xff, PNG_FILLER_BEFORE);
-#else
-		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
-			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
-#endif
-
+		setARGBTransforms(pngPtr, bitDepth, colorType);
 	}
 
 	// After the transformations have been registered, the image data is read again.
@@ -242,6 +247,118 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 #endif
 }
 
+bool PNGDecoder::loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst,
+                                const Graphics::PixelFormat &format, const Common::Rect &srcRect) {
+#ifdef USE_PNG
+	destroy();
+
+	const Graphics::PixelFormat &dstFormat = dst.getPixels() ? dst.format : format;
+	if (dstFormat.bytesPerPixel != 2 && dstFormat.bytesPerPixel != 4)
+		return false;
+
+	int32 startPos = stream.pos();
+
+	if (!_skipSignature) {
+		if (stream.readUint32BE() != MKTAG(0x89, 'P', 'N', 'G')) {
+			return false;
+		}
+		if (stream.readUint32BE() != MKTAG(0x0d, 0x0a, 0x1a, 0x0a)) {
+			return false;
+		}
+	}
+
+	png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+	if (!pngPtr) {
+		return false;
+	}
+	png_infop infoPtr = png_create_info_struct(pngPtr);
+	if (!infoPtr) {
+		png_destroy_read_struct(&pngPtr, NULL, NULL);
+		return false;
+	}
+
+	png_set_error_fn(pngPtr, NULL, pngError, pngWarning);
+	png_set_read_fn(pngPtr, &stream, pngReadFromStream);
+	png_set_crc_action(pngPtr, PNG_CRC_DEFAULT, PNG_CRC_WARN_USE);
+	png_set_sig_bytes(pngPtr, 8);
+
+	png_read_info(pngPtr, infoPtr);
+
+	int bitDepth, colorType, interlaceType;
+	png_uint_32 width, height;
+	png_get_IHDR(pngPtr, infoPtr, &width, &height, &bitDepth, &colorType, &interlaceType, NULL, NULL);
+
+	Common::Rect area(width, height);
+	if (!srcRect.isEmpty())
+		area.clip(srcRect);
+
+	// A source rect outside of the image would make the row loop below
+	// read past the end of the image
+	if (area.isEmpty()) {
+		png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+		return false;
+	}
+
+	if (!dst.getPixels())
+		dst.create(area.width(), area.height(), format);
+
+	area.setWidth(MIN<int16>(area.width(), dst.w));
+	area.setHeight(MIN<int16>(area.height(), dst.h));
+
+	if (area.isEmpty()) {
+		png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+		return false;
+	}
+
+	if (interlaceType != PNG_INTERLACE_NONE) {
+		// Rows of interlaced images are only complete after the last pass,
+		// so these have to go through a full size image.
+		png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+		stream.seek(startPos);
+
+		if (!loadStream(stream))
+			return false;
+
+		Graphics::Surface *converted = _outputSurface->convertTo(dst.format, _palette);
+		dst.copyRectToSurface(*converted, 0, 0, area);
+		converted->free();
+		delete converted;
+
+		destroy();
+		return true;
+	}
+
+	// Every row is expanded to ARGB, and then converted to the target format
+	if (colorType == PNG_COLOR_TYPE_PALETTE)
+		png_set_expand(pngPtr);
+	else if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))
+		png_set_expand(pngPtr);
+	setARGBTransforms(pngPtr, bitDepth, colorType);
+	png_read_update_info(pngPtr, infoPtr);
+
+	const Graphics::PixelFormat rowFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	byte *row = new byte[width * 4];
+
+	for (int y = 0; y < area.bottom; y++) {
+		png_read_row(pngPtr, row, NULL);
+
+		if (y >= area.top) {
+			Graphics::crossBlit((byte *)dst.getBasePtr(0, y - area.top), row + area.left * 4,
+			                    dst.pitch, width * 4, area.width(), 1, dst.format, rowFormat);
+		}
+	}
+
+	delete[] row;
+
+	// The rows below the requested area are never decoded
+	png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool writePNG(Common::WriteStream &out, const Graphics::Surface &input, const bool bottomUp) {
 #ifdef USE_PNG
 	const Graphics::PixelFormat requiredFormat_3byte(3, 8, 8, 8, 0, 16, 8, 0, 0);
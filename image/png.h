@@ -32,6 +32,7 @@
 #define IMAGE_PNG_H
 
 #include "common/scummsys.h"
+#include "common/rect.h"
 #include "common/textconsole.h"
 #include "image/image_decoder.h"
 
@@ -41,6 +42,7 @@ class WriteStream;
 }
 
 namespace Graphics {
+struct PixelFormat;
 struct Surface;
 }
 
@@ -57,6 +59,30 @@ public:
 	const byte *getPalette() const { return _palette; }
 	uint16 getPaletteColorCount() const { return _paletteColorCount; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
+
+	/**
+	 * Decode the image straight into a surface provided by the caller.
+	 *
+	 * The image is decoded row by row, and every row is converted to the
+	 * pixel format of the target surface as soon as it has been read. No
+	 * full size copy of the image is made, except for interlaced images.
+	 * The decoder's own surface is not used, getSurface() returns 0
+	 * afterwards.
+	 *
+	 * @param stream  the stream to read the image from
+	 * @param dst     the surface to decode into. If it has not been created
+	 *                yet, it is created with the size of the decoded area.
+	 *                Otherwise the decoded area is clipped to its size.
+	 * @param format  the pixel format to create dst with, if needed.
+	 *                Only 2 and 4 bytes per pixel are supported.
+	 * @param srcRect the part of the image to decode, which is placed in
+	 *                the top left corner of dst. An empty rect (the
+	 *                default) decodes the whole image.
+	 * @return whether the image could be decoded. This fails without
+	 *         touching dst if the decoded area is empty.
+	 */
+	bool loadStreamInto(Common::SeekableReadStream &stream, Graphics::Surface &dst,
+	                    const Graphics::PixelFormat &format, const Common::Rect &srcRect = Common::Rect());
 private:
 	byte *_palette;
 	uint16 _paletteColorCount;
@@ -0,0 +1,100 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+#include "common/array.h"
+#include "common/list.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_allocate() {
+		Common::Arena arena(64);
+		byte *a = (byte *)arena.allocate(3);
+		byte *b = (byte *)arena.allocate(8);
+		TS_ASSERT_EQUALS(b - a, 16);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 32U);
+
+		// Larger than a block
+		byte *c = (byte *)arena.allocate(100);
+		memset(c, 0, 100);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 144U);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		TS_ASSERT_EQUALS(arena.allocate(4), a);
+	}
+
+	void test_rewind() {
+		Common::Arena arena(64);
+		arena.allocate(40);
+		const Common::Arena::Marker marker = arena.getMarker();
+		byte *a = (byte *)arena.allocate(16);
+		arena.allocate(32);
+		arena.allocate(32);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 128U);
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 48U);
+		TS_ASSERT_EQUALS(arena.allocate(16), a);
+
+		{
+			Common::ArenaScope scope(arena);
+			arena.allocate(64);
+			TS_ASSERT_EQUALS(arena.getUsedSize(), 128U);
+		}
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 64U);
+
+		arena.reset();
+		arena.freeUnusedBlocks();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		arena.allocate(8);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 16U);
+	}
+
+	void test_default_size() {
+		// Containers using the default allocator do not grow because of it
+		struct ArrayLayout {
+			uint capacity, size;
+			int *storage;
+		};
+		TS_ASSERT_EQUALS(sizeof(Common::Array<int>), sizeof(ArrayLayout));
+		TS_ASSERT_EQUALS(sizeof(Common::List<int>), 2 * sizeof(void *));
+	}
+
+	void test_array() {
+		Common::Arena arena;
+		Common::ArenaScope scope(arena);
+
+		Common::Array<int, Common::ArenaAllocator> array(arena);
+		for (int i = 0; i < 100; ++i)
+			array.push_back(i);
+		TS_ASSERT_EQUALS(array.size(), 100U);
+		TS_ASSERT_EQUALS(array[99], 99);
+		TS_ASSERT_LESS_THAN(0U, arena.getUsedSize());
+
+		// Copies use the same arena
+		Common::Array<int, Common::ArenaAllocator> copy(array);
+		TS_ASSERT(copy == array);
+		const size_t used = arena.getUsedSize();
+		copy.push_back(100);
+		TS_ASSERT_LESS_THAN(used, arena.getUsedSize());
+	}
+
+	void test_list() {
+		Common::Arena arena;
+		Common::ArenaScope scope(arena);
+
+		Common::List<int, Common::ArenaAllocator> list(arena);
+		list.push_back(1);
+		list.push_back(2);
+		list.push_front(0);
+		TS_ASSERT_EQUALS(list.size(), 3U);
+		TS_ASSERT_EQUALS(list.front(), 0);
+		TS_ASSERT_EQUALS(list.back(), 2);
+
+		list.pop_front();
+		TS_ASSERT_EQUALS(list.front(), 1);
+		list.clear();
+		TS_ASSERT(list.empty());
+	}
+};
@@ -0,0 +1,86 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/atom.h"
+#include "common/hash-str.h"
+
+class AtomTestSuite : public CxxTest::TestSuite
+{
+	// An archive which only knows about its String lookups
+	class NameArchive : public Common::Archive {
+	public:
+		Common::String _name;
+
+		bool hasFile(const Common::String &name) const { return name.equalsIgnoreCase(_name); }
+		int listMembers(Common::ArchiveMemberList &list) const { return 0; }
+		const Common::ArchiveMemberPtr getMember(const Common::String &name) const { return Common::ArchiveMemberPtr(); }
+		Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const { return 0; }
+	};
+
+	public:
+	void test_interning() {
+		Common::Atom a("Atom_Test_File.DAT");
+		Common::Atom b(Common::String("atom_test_file.dat"));
+		Common::Atom c("atom_test_other.dat");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.hash(), b.hash());
+		TS_ASSERT_EQUALS(a.hash(), Common::hashit_lower("ATOM_TEST_FILE.dat"));
+		// The first spelling is kept
+		TS_ASSERT_EQUALS(b.toString(), "Atom_Test_File.DAT");
+		TS_ASSERT_EQUALS(strcmp(b.c_str(), "Atom_Test_File.DAT"), 0);
+	}
+
+	void test_empty() {
+		Common::Atom a;
+		Common::Atom b("");
+		TS_ASSERT(a.empty());
+		TS_ASSERT(a == b);
+		TS_ASSERT(a != Common::Atom("atom_test_nonempty"));
+		TS_ASSERT_EQUALS(a.toString(), "");
+	}
+
+	void test_find() {
+		Common::Atom a;
+		TS_ASSERT(!Common::Atom::find("atom_test_never_interned", a));
+		TS_ASSERT(!Common::Atom::find("atom_test_never_interned", a));
+
+		Common::Atom b("Atom_Test_Found");
+		TS_ASSERT(Common::Atom::find("ATOM_TEST_FOUND", a));
+		TS_ASSERT(a == b);
+
+		TS_ASSERT(Common::Atom::find("", a));
+		TS_ASSERT(a.empty());
+	}
+
+	void test_hashmap() {
+		Common::HashMap<Common::Atom, int> map;
+		map[Common::Atom("atom_test_one")] = 1;
+		map[Common::Atom("atom_test_two")] = 2;
+		TS_ASSERT_EQUALS(map[Common::Atom("ATOM_TEST_ONE")], 1);
+		TS_ASSERT_EQUALS(map.size(), 2U);
+
+		Common::HashMap<Common::Atom, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> map2;
+		map2[Common::Atom("atom_test_one")] = 1;
+		TS_ASSERT(map2.contains(Common::Atom("Atom_Test_One")));
+		TS_ASSERT(!map2.contains(Common::Atom("atom_test_two")));
+	}
+
+	void test_archive() {
+		// Archives which do not override the Atom lookups fall back to
+		// their String ones
+		NameArchive archive;
+		archive._name = "Atom_Test_Member";
+		const Common::Archive &base = archive;
+		TS_ASSERT(base.hasFile(Common::Atom("atom_test_member")));
+		TS_ASSERT(!base.hasFile(Common::Atom("atom_test_nonmember")));
+
+		Common::SearchSet set;
+		set.add("test", &archive, 0, false);
+		TS_ASSERT(set.hasFile(Common::Atom("ATOM_TEST_MEMBER")));
+		TS_ASSERT(!set.hasFile(Common::Atom()));
+		TS_ASSERT(set.hasFile("atom_test_member"));
+		TS_ASSERT_EQUALS(set.createReadStreamForMember(Common::Atom("atom_test_member")), (Common::SeekableReadStream *)0);
+	}
+};
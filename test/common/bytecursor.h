@@ -0,0 +1,119 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bytecursor.h"
+#include "common/memstream.h"
+#include "common/substream.h"
+
+class ByteCursorTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_read() {
+		const byte data[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xFF };
+		Common::ByteCursor cursor(data, sizeof(data));
+		TS_ASSERT_EQUALS(cursor.size(), 9U);
+		TS_ASSERT_EQUALS(cursor.readUint16LE(), 0x3412);
+		TS_ASSERT_EQUALS(cursor.readUint16BE(), 0x5678);
+		TS_ASSERT_EQUALS(cursor.readUint32BE(), 0x9ABCDEF0U);
+		TS_ASSERT_EQUALS(cursor.readSByte(), -1);
+		TS_ASSERT_EQUALS(cursor.remaining(), 0U);
+		TS_ASSERT(!cursor.eos());
+
+		TS_ASSERT(cursor.seek(4));
+		TS_ASSERT_EQUALS(cursor.readUint32LE(), 0xF0DEBC9AU);
+		TS_ASSERT(cursor.seek(0));
+		TS_ASSERT_EQUALS(cursor.readSint16BE(), 0x1234);
+		TS_ASSERT(cursor.skip(2));
+		TS_ASSERT_EQUALS(cursor.readSint32LE(), (int32)0xF0DEBC9A);
+		TS_ASSERT(!cursor.seek(10));
+		TS_ASSERT_EQUALS(cursor.pos(), 8U);
+	}
+
+	void test_eos() {
+		const byte data[] = { 1, 2, 3 };
+		Common::ByteCursor cursor(data, sizeof(data));
+		cursor.readByte();
+		TS_ASSERT_EQUALS(cursor.readUint32BE(), 0U);
+		TS_ASSERT(cursor.eos());
+		TS_ASSERT_EQUALS(cursor.pos(), 3U);
+
+		TS_ASSERT(cursor.seek(1));
+		TS_ASSERT(!cursor.eos());
+		byte buffer[4];
+		TS_ASSERT_EQUALS(cursor.read(buffer, 4), 2U);
+		TS_ASSERT_EQUALS(buffer[0], 2);
+		TS_ASSERT_EQUALS(buffer[1], 3);
+		TS_ASSERT(cursor.eos());
+	}
+
+	void test_arrays() {
+		const byte data[] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xFF };
+		Common::ByteCursor cursor(data, sizeof(data));
+
+		uint16 words[5];
+		TS_ASSERT_EQUALS(cursor.readUint16BEArray(words, 3), 3U);
+		TS_ASSERT_EQUALS(words[0], 0x1234);
+		TS_ASSERT_EQUALS(words[2], 0x9ABC);
+		TS_ASSERT(!cursor.eos());
+
+		cursor.seek(0);
+		TS_ASSERT_EQUALS(cursor.readUint16LEArray(words, 5), 4U);
+		TS_ASSERT_EQUALS(words[3], 0xF0DE);
+		TS_ASSERT(cursor.eos());
+
+		uint32 dwords[2];
+		cursor.seek(0);
+		TS_ASSERT_EQUALS(cursor.readUint32LEArray(dwords, 2), 2U);
+		TS_ASSERT_EQUALS(dwords[0], 0x78563412U);
+		TS_ASSERT_EQUALS(dwords[1], 0xF0DEBC9AU);
+		cursor.seek(1);
+		TS_ASSERT_EQUALS(cursor.readUint32BEArray(dwords, 2), 2U);
+		TS_ASSERT_EQUALS(dwords[1], 0xBCDEF0FFU);
+	}
+
+	void test_stream_arrays() {
+		const byte data[] = { 0x12, 0x34, 0x56, 0x78, 0x9A };
+		Common::MemoryReadStream stream(data, sizeof(data));
+		uint16 words[3];
+		TS_ASSERT_EQUALS(stream.readUint16BEArray(words, 3), 2U);
+		TS_ASSERT_EQUALS(words[0], 0x1234);
+		TS_ASSERT_EQUALS(words[1], 0x5678);
+		TS_ASSERT(stream.eos());
+	}
+
+	void test_memory_stream() {
+		const byte data[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream stream(data, sizeof(data));
+		stream.seek(2);
+
+		Common::ByteCursor cursor;
+		TS_ASSERT(stream.getCursor(cursor));
+		TS_ASSERT_EQUALS(cursor.size(), 8U);
+		TS_ASSERT_EQUALS(cursor.pos(), 2U);
+		TS_ASSERT_EQUALS(cursor.readByte(), 2);
+		TS_ASSERT_EQUALS(stream.pos(), 2);
+
+		stream.seek(cursor.pos());
+		TS_ASSERT_EQUALS(stream.readByte(), 3);
+	}
+
+	void test_sub_stream() {
+		const byte data[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream stream(data, sizeof(data));
+		Common::SeekableSubReadStream sub(&stream, 2, 6);
+		sub.readByte();
+
+		Common::ByteCursor cursor;
+		TS_ASSERT(sub.getCursor(cursor));
+		TS_ASSERT_EQUALS(cursor.size(), 4U);
+		TS_ASSERT_EQUALS(cursor.pos(), 1U);
+		TS_ASSERT_EQUALS(cursor.readUint16BE(), 0x0304);
+		TS_ASSERT_EQUALS(cursor.readUint16BE(), 0);
+		TS_ASSERT(cursor.eos());
+
+		// Substreams of substreams work as well
+		Common::SeekableSubReadStream subSub(&sub, 1, 3);
+		TS_ASSERT(subSub.getCursor(cursor));
+		TS_ASSERT_EQUALS(cursor.size(), 2U);
+		TS_ASSERT_EQUALS(cursor.readByte(), 3);
+	}
+};
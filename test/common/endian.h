@@ -45,4 +45,25 @@ class EndianTestSuite : public CxxTest::TestSuite
 		uint32 value = READ_LE_UINT16(data);
 		TS_ASSERT_EQUALS(value, 0x3412UL);
 	}
+
+	void test_swapBytes16() {
+		// Long enough to cover both the vectorized loop and the remainder
+		const uint count = 19;
+		uint16 data[count];
+		for (uint i = 0; i < count; ++i)
+			data[i] = 0x0102 * (i + 1);
+		Common::swapBytes16(data, count);
+		for (uint i = 0; i < count; ++i)
+			TS_ASSERT_EQUALS(data[i], SWAP_BYTES_16(0x0102 * (i + 1)));
+	}
+
+	void test_swapBytes32() {
+		const uint count = 11;
+		uint32 data[count];
+		for (uint i = 0; i < count; ++i)
+			data[i] = 0x01020304 * (i + 1);
+		Common::swapBytes32(data, count);
+		for (uint i = 0; i < count; ++i)
+			TS_ASSERT_EQUALS(data[i], SWAP_BYTES_32(0x01020304 * (i + 1)));
+	}
 };
@@ -0,0 +1,143 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	public:
+	void setUp() {
+		_seed = 1;
+	}
+
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		TS_ASSERT(container2.contains("FOO"));
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		TS_ASSERT_EQUALS(container.size(), 2U);
+		container[1] = 42;
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(container.find(0));
+		container.erase(container.find(1));
+		container.erase(2);
+		TS_ASSERT(container.empty());
+		TS_ASSERT_EQUALS(container.find(2), container.end());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getVal.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getVal(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(container.size(), 2U);
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<int, Common::String> map1, map2;
+		for (int i = 0; i < 100; i++)
+			map1[i * 7] = Common::String::format("%d", i);
+		map1.erase(14);
+
+		map2 = map1;
+		Common::FlatHashMap<int, Common::String> map3(map1);
+		map1.clear();
+
+		TS_ASSERT_EQUALS(map2.size(), 99U);
+		TS_ASSERT_EQUALS(map3.size(), 99U);
+		TS_ASSERT(!map2.contains(14));
+		TS_ASSERT_EQUALS(map2[693], "99");
+		TS_ASSERT_EQUALS(map3[693], "99");
+	}
+
+	void test_erase_while_iterating() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 1000; i++)
+			container[i] = i;
+
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			if (i->_key & 1)
+				container.erase(i);
+		}
+
+		TS_ASSERT_EQUALS(container.size(), 500U);
+		int sum = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = container.begin(); i != container.end(); ++i) {
+			TS_ASSERT_EQUALS(i->_key & 1, 0);
+			sum += i->_value;
+		}
+		TS_ASSERT_EQUALS(sum, 499 * 500 / 2 * 2);
+	}
+
+	// Run the same random sequence of operations on a FlatHashMap and a
+	// HashMap, and check that they always agree. The keys are multiples of
+	// 4096 so that they only differ in the upper bits, and are added and
+	// erased often enough to exercise the reuse of erased slots.
+	void test_matches_hashmap() {
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+
+		for (int i = 0; i < 20000; i++) {
+			const uint key = (nextRandom() % 2048) * 4096;
+			switch (nextRandom() % 3) {
+			case 0:
+				flat[key] = i;
+				reference[key] = i;
+				break;
+			case 1:
+				flat.erase(key);
+				reference.erase(key);
+				break;
+			default:
+				TS_ASSERT_EQUALS(flat.contains(key), reference.contains(key));
+				TS_ASSERT_EQUALS(((const Common::FlatHashMap<uint, uint> &)flat).getVal(key), ((const Common::HashMap<uint, uint> &)reference).getVal(key));
+				break;
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i, ++count)
+			TS_ASSERT_EQUALS(i->_value, reference[i->_key]);
+		TS_ASSERT_EQUALS(count, reference.size());
+	}
+};
@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/fs/abstract-fs.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+
+// A file system in memory with a clock which only moves when told to
+struct FakeFileSystem {
+	struct File {
+		bool _isDirectory;
+		uint32 _time;
+		Common::Array<byte> _data;
+	};
+	typedef Common::HashMap<Common::String, File> FileMap;
+
+	FileMap _files;
+	uint32 _clock;
+	int _listings;
+
+	FakeFileSystem() : _clock(0), _listings(0) {}
+
+	static Common::String parentOf(const Common::String &path) {
+		const char *slash = strrchr(path.c_str(), '/');
+		return slash ? Common::String(path.c_str(), slash) : Common::String();
+	}
+
+	void add(const Common::String &path, bool isDirectory) {
+		File &file = _files[path];
+		file._isDirectory = isDirectory;
+		file._time = _clock;
+		if (_files.contains(parentOf(path)))
+			_files[parentOf(path)]._time = _clock;
+	}
+};
+
+class FakeWriteStream : public Common::WriteStream {
+	FakeFileSystem *_fs;
+	Common::String _path;
+
+public:
+	FakeWriteStream(FakeFileSystem *fs, const Common::String &path) : _fs(fs), _path(path) {}
+
+	virtual uint32 write(const void *dataPtr, uint32 dataSize) {
+		Common::Array<byte> &data = _fs->_files[_path]._data;
+		const byte *bytes = (const byte *)dataPtr;
+		for (uint32 i = 0; i < dataSize; i++)
+			data.push_back(bytes[i]);
+		return dataSize;
+	}
+
+	virtual int32 pos() const {
+		return _fs->_files[_path]._data.size();
+	}
+};
+
+class FakeFSNode : public AbstractFSNode {
+	FakeFileSystem *_fs;
+	Common::String _path;
+
+public:
+	FakeFSNode(FakeFileSystem *fs, const Common::String &path) : _fs(fs), _path(path) {}
+
+	virtual AbstractFSNode *getChild(const Common::String &name) const {
+		return new FakeFSNode(_fs, _path + "/" + name);
+	}
+
+	virtual AbstractFSNode *getParent() const {
+		return new FakeFSNode(_fs, FakeFileSystem::parentOf(_path));
+	}
+
+	virtual bool exists() const {
+		return _fs->_files.contains(_path);
+	}
+
+	virtual bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const {
+		_fs->_listings++;
+		for (FakeFileSystem::FileMap::const_iterator it = _fs->_files.begin(); it != _fs->_files.end(); ++it) {
+			if (FakeFileSystem::parentOf(it->_key) != _path)
+				continue;
+			if (mode == Common::FSNode::kListFilesOnly && it->_value._isDirectory)
+				continue;
+			if (mode == Common::FSNode::kListDirectoriesOnly && !it->_value._isDirectory)
+				continue;
+			list.push_back(new FakeFSNode(_fs, it->_key));
+		}
+		return true;
+	}
+
+	virtual Common::String getName() const {
+		const char *slash = strrchr(_path.c_str(), '/');
+		return slash ? slash + 1 : _path.c_str();
+	}
+
+	virtual Common::String getPath() const {
+		return _path;
+	}
+
+	virtual bool isDirectory() const {
+		return exists() && _fs->_files[_path]._isDirectory;
+	}
+
+	virtual bool isReadable() const {
+		return exists();
+	}
+
+	virtual bool isWritable() const {
+		return true;
+	}
+
+	virtual bool getModificationTime(uint32 &time) const {
+		if (!exists())
+			return false;
+		time = _fs->_files[_path]._time;
+		return true;
+	}
+
+	virtual Common::SeekableReadStream *createReadStream() {
+		if (!exists())
+			return 0;
+		const Common::Array<byte> &data = _fs->_files[_path]._data;
+		byte *copy = (byte *)malloc(data.size() + 1);
+		for (uint i = 0; i < data.size(); i++)
+			copy[i] = data[i];
+		return new Common::MemoryReadStream(copy, data.size(), DisposeAfterUse::YES);
+	}
+
+	virtual Common::WriteStream *createWriteStream() {
+		_fs->add(_path, false);
+		_fs->_files[_path]._data.clear();
+		return new FakeWriteStream(_fs, _path);
+	}
+
+	virtual bool create(bool isDirectoryFlag) {
+		_fs->add(_path, isDirectoryFlag);
+		return true;
+	}
+};
+
+class FSDirectoryTestSuite : public CxxTest::TestSuite
+{
+	// Build the cache of /game with the index in /index, returning whether name was found
+	bool scan(FakeFileSystem &fs, const char *name) {
+		Common::FSDirectory dir(AbstractFSNode::makeFSNode(new FakeFSNode(&fs, "/game")), 2);
+		dir.setIndexFile(AbstractFSNode::makeFSNode(new FakeFSNode(&fs, "/index")));
+		fs._listings = 0;
+		return dir.hasFile(name);
+	}
+
+public:
+	void test_index_roundtrip() {
+		FakeFileSystem fs;
+		fs._clock = 5;
+		fs.add("/game", true);
+		fs.add("/game/a.dat", false);
+		fs.add("/game/sub", true);
+		fs.add("/game/sub/b.dat", false);
+
+		// Without an index, every directory is listed
+		fs._clock = 10;
+		TS_ASSERT(scan(fs, "sub/b.dat"));
+		TS_ASSERT_EQUALS(fs._listings, 2);
+
+		// Unchanged directories come from the index
+		TS_ASSERT(scan(fs, "a.dat"));
+		TS_ASSERT_EQUALS(fs._listings, 0);
+
+		// Only the modified directory is listed again
+		fs._clock = 20;
+		fs.add("/game/sub/c.dat", false);
+		TS_ASSERT(scan(fs, "sub/c.dat"));
+		TS_ASSERT_EQUALS(fs._listings, 1);
+
+		// Modified again in the second that scan started: the time of the
+		// directory is the same as in the index, but it must not be trusted
+		fs.add("/game/sub/d.dat", false);
+		fs._clock = 30;
+		TS_ASSERT(scan(fs, "sub/d.dat"));
+		TS_ASSERT_EQUALS(fs._listings, 1);
+
+		// Listed after that second, so it can be trusted again
+		TS_ASSERT(scan(fs, "sub/d.dat"));
+		TS_ASSERT_EQUALS(fs._listings, 0);
+	}
+};
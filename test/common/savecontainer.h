@@ -0,0 +1,155 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/savecontainer.h"
+#include "common/substream.h"
+#include "common/zlib.h"
+
+class SaveContainerTestSuite : public CxxTest::TestSuite
+{
+	// Write a container with the given metadata and body into memory
+	Common::SeekableReadStream *writeContainer(const Common::String &meta, const byte *body, uint32 bodySize, int level, bool dedup, uint32 *containerSize = 0) {
+		Common::MemoryWriteStreamDynamic *memory = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::SaveContainerWriteStream container(memory, level, dedup);
+		container.write(meta.c_str(), meta.size());
+		container.endMetadata();
+		container.write(body, bodySize);
+		TS_ASSERT_EQUALS(container.pos(), (int32)(meta.size() + bodySize));
+		container.finalize();
+		TS_ASSERT(!container.err());
+
+		if (containerSize)
+			*containerSize = memory->size();
+		return new Common::MemoryReadStream(memory->getData(), memory->size(), DisposeAfterUse::YES);
+	}
+
+	void checkRoundtrip(int level, bool dedup) {
+		const uint32 bodySize = 200000;
+		byte *body = new byte[bodySize];
+		for (uint32 i = 0; i < bodySize; ++i)
+			body[i] = (i * 7) ^ (i >> 9);
+
+		Common::SeekableReadStream *s = Common::wrapCompressedReadStream(writeContainer("HEADER", body, bodySize, level, dedup));
+		TS_ASSERT_EQUALS(s->size(), (int32)(6 + bodySize));
+
+		char meta[7] = {};
+		TS_ASSERT_EQUALS(s->read(meta, 6), 6U);
+		TS_ASSERT_EQUALS(strcmp(meta, "HEADER"), 0);
+
+		byte *buffer = new byte[bodySize];
+		TS_ASSERT_EQUALS(s->read(buffer, bodySize), bodySize);
+		TS_ASSERT_EQUALS(memcmp(buffer, body, bodySize), 0);
+		TS_ASSERT(!s->eos());
+		TS_ASSERT(!s->err());
+
+		s->readByte();
+		TS_ASSERT(s->eos());
+
+		// Seek backwards into the body, and across the metadata boundary
+		TS_ASSERT(s->seek(6 + 70000));
+		TS_ASSERT_EQUALS(s->readByte(), body[70000]);
+		TS_ASSERT(s->seek(4));
+		TS_ASSERT_EQUALS(s->read(buffer, 4), 4U);
+		TS_ASSERT_EQUALS(memcmp(buffer, "ER", 2), 0);
+		TS_ASSERT_EQUALS(memcmp(buffer + 2, body, 2), 0);
+		TS_ASSERT(s->seek(-1, SEEK_END));
+		TS_ASSERT_EQUALS(s->readByte(), body[bodySize - 1]);
+
+		delete[] buffer;
+		delete[] body;
+		delete s;
+	}
+
+	public:
+	void test_roundtrip() {
+		checkRoundtrip(Common::kSaveCompressionStore, false);
+		checkRoundtrip(Common::kSaveCompressionFast, true);
+		checkRoundtrip(Common::kSaveCompressionBest, false);
+	}
+
+	void test_metadata_only() {
+		// Reading the metadata must not need the body at all, so reading it
+		// from a truncated container works
+		Common::SeekableReadStream *s = writeContainer("HEADER", (const byte *)"BODY", 4, Common::kSaveCompressionFast, true);
+		Common::SeekableReadStream *truncated = new Common::SeekableSubReadStream(s, 0, 22, DisposeAfterUse::YES);
+		Common::SaveContainerReadStream container(truncated);
+		TS_ASSERT_EQUALS(container.getMetadataSize(), 6U);
+		char meta[7] = {};
+		TS_ASSERT_EQUALS(container.read(meta, 6), 6U);
+		TS_ASSERT_EQUALS(strcmp(meta, "HEADER"), 0);
+		TS_ASSERT(!container.err());
+
+		container.readByte();
+		TS_ASSERT(container.err());
+	}
+
+	void test_without_metadata() {
+		Common::MemoryWriteStreamDynamic *memory = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::SaveContainerWriteStream *container = new Common::SaveContainerWriteStream(memory);
+		container->writeUint32BE(0x12345678);
+		container->finalize();
+		Common::SaveContainerReadStream s(new Common::MemoryReadStream(memory->getData(), memory->size(), DisposeAfterUse::YES));
+		delete container;
+		TS_ASSERT_EQUALS(s.getMetadataSize(), 0U);
+		TS_ASSERT_EQUALS(s.size(), 4);
+		TS_ASSERT_EQUALS(s.readUint32BE(), 0x12345678U);
+	}
+
+	void test_dedup() {
+		// The body consists of 16 identical blocks
+		const uint32 bodySize = 16 * 65536;
+		byte *body = new byte[bodySize];
+		for (uint32 i = 0; i < bodySize; ++i)
+			body[i] = ((i & 0xFFFF) * 2654435761U) >> 24;
+
+		uint32 dedupSize, plainSize;
+		delete writeContainer("", body, bodySize, Common::kSaveCompressionStore, true, &dedupSize);
+		Common::SeekableReadStream *s = Common::wrapCompressedReadStream(writeContainer("", body, bodySize, Common::kSaveCompressionStore, false, &plainSize));
+		TS_ASSERT_LESS_THAN(dedupSize, 65536U * 2);
+		TS_ASSERT_LESS_THAN(bodySize, plainSize);
+
+		Common::SeekableReadStream *d = Common::wrapCompressedReadStream(writeContainer("", body, bodySize, Common::kSaveCompressionStore, true));
+		byte *buffer = new byte[bodySize];
+		TS_ASSERT_EQUALS(d->read(buffer, bodySize), bodySize);
+		TS_ASSERT_EQUALS(memcmp(buffer, body, bodySize), 0);
+
+		delete[] buffer;
+		delete[] body;
+		delete d;
+		delete s;
+	}
+
+	void test_oversized_index() {
+		const byte body[] = { 1, 2, 3, 4, 5 };
+		Common::SeekableReadStream *c = writeContainer("meta", body, sizeof(body), Common::kSaveCompressionStore, false);
+		const uint32 size = c->size();
+		byte *data = (byte *)malloc(size);
+		TS_ASSERT_EQUALS(c->read(data, size), size);
+		delete c;
+
+		// Claim a body of byte sized blocks, with a block count far larger
+		// than the index could hold
+		const uint32 bodySize = 0xFFFFFF00;
+		WRITE_BE_UINT32(data + 12, 1);
+		WRITE_BE_UINT32(data + size - 16, bodySize);
+		WRITE_BE_UINT32(data + size - 12, bodySize);
+
+		Common::SeekableReadStream *s = Common::wrapCompressedReadStream(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES));
+		char meta[4];
+		TS_ASSERT_EQUALS(s->read(meta, sizeof(meta)), sizeof(meta));
+		TS_ASSERT_EQUALS(memcmp(meta, "meta", sizeof(meta)), 0);
+		TS_ASSERT_EQUALS(s->size(), (int32)sizeof(meta));
+		TS_ASSERT_EQUALS(s->readByte(), 0);
+		TS_ASSERT(s->err());
+		delete s;
+	}
+
+	void test_not_a_container() {
+		Common::MemoryReadStream s((const byte *)"SCN", 3);
+		TS_ASSERT(!Common::isSaveContainer(s));
+		TS_ASSERT_EQUALS(s.pos(), 0);
+		Common::MemoryReadStream s2((const byte *)"SCNT", 4);
+		TS_ASSERT(Common::isSaveContainer(s2));
+		TS_ASSERT_EQUALS(s2.pos(), 0);
+	}
+};
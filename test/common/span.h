@@ -623,6 +623,13 @@ public:
 			TS_ASSERT_EQUALS(out, 3);
 			TS_ASSERT_EQUALS(stream.read(&out, 1), 0U);
 		}
+
+		{
+			Common::ByteCursor cursor = span.toCursor(1, 2);
+			TS_ASSERT_EQUALS(cursor.size(), 2U);
+			TS_ASSERT_EQUALS(cursor.readUint16BE(), 0x0102);
+			TS_ASSERT(!cursor.eos());
+		}
 	}
 
 	void test_span_copying() {
@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/pixelformat.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite
+{
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	static uint32 readPixel(const byte *src, int bytesPerPixel) {
+		if (bytesPerPixel == 2)
+			return *(const uint16 *)src;
+		else
+			return *(const uint32 *)src;
+	}
+
+	// Compare crossBlit against converting every pixel through colorToARGB/ARGBToColor
+	void checkCrossBlit(const Graphics::PixelFormat &srcFmt, const Graphics::PixelFormat &dstFmt) {
+		const uint w = 7, h = 5;
+		const uint srcPitch = (w + 1) * srcFmt.bytesPerPixel;
+		const uint dstPitch = (w + 3) * dstFmt.bytesPerPixel;
+
+		byte src[h * (w + 1) * 4];
+		for (uint i = 0; i < sizeof(src); i++)
+			src[i] = nextRandom() & 0xFF;
+
+		byte dst[h * (w + 3) * 4];
+		TS_ASSERT(Graphics::crossBlit(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt));
+
+		for (uint y = 0; y < h; y++) {
+			for (uint x = 0; x < w; x++) {
+				byte a, r, g, b;
+				srcFmt.colorToARGB(readPixel(src + y * srcPitch + x * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel), a, r, g, b);
+				TS_ASSERT_EQUALS(readPixel(dst + y * dstPitch + x * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel), dstFmt.ARGBToColor(a, r, g, b));
+			}
+		}
+
+		// Also convert in place, as a whole contiguous area
+		byte buffer[w * h * 4];
+		memcpy(buffer, src, w * h * srcFmt.bytesPerPixel);
+		TS_ASSERT(Graphics::crossBlit(buffer, buffer, w * dstFmt.bytesPerPixel, w * srcFmt.bytesPerPixel, w, h, dstFmt, srcFmt));
+
+		for (uint i = 0; i < w * h; i++) {
+			byte a, r, g, b;
+			srcFmt.colorToARGB(readPixel(src + i * srcFmt.bytesPerPixel, srcFmt.bytesPerPixel), a, r, g, b);
+			TS_ASSERT_EQUALS(readPixel(buffer + i * dstFmt.bytesPerPixel, dstFmt.bytesPerPixel), dstFmt.ARGBToColor(a, r, g, b));
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 1;
+	}
+
+	void test_crossBlit() {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		// Identical formats are simply copied, unused bits included, so skip them
+		for (uint i = 0; i < ARRAYSIZE(formats); i++)
+			for (uint j = 0; j < ARRAYSIZE(formats); j++)
+				if (i != j)
+					checkCrossBlit(formats[i], formats[j]);
+	}
+};
@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/font.h"
+
+class FontTestSuite : public CxxTest::TestSuite
+{
+	// A font whose characters are all as wide as told
+	class FixedFont : public Graphics::Font {
+	public:
+		int _charWidth;
+
+		FixedFont() : _charWidth(6) {}
+
+		int getFontHeight() const { return 8; }
+		int getMaxCharWidth() const { return _charWidth; }
+		int getCharWidth(uint32 chr) const { return _charWidth; }
+		void drawChar(Graphics::Surface *dst, uint32 chr, int x, int y, uint32 color) const {}
+	};
+
+public:
+	void test_wordWrapText_cache() {
+		const Common::String text("The quick brown fox jumps over the lazy dog");
+		FixedFont font;
+		font.setWordWrapCacheSize(2);
+
+		Common::Array<Common::String> expected;
+		FixedFont uncached;
+		int expectedWidth = uncached.wordWrapText(text, 60, expected);
+
+		// Wrap twice, so that the second call comes from the cache. The
+		// lines are appended to what is already in the array.
+		for (int i = 0; i < 2; i++) {
+			Common::Array<Common::String> lines;
+			lines.push_back("first");
+			TS_ASSERT_EQUALS(font.wordWrapText(text, 60, lines), expectedWidth);
+			TS_ASSERT_EQUALS(lines.size(), expected.size() + 1);
+			TS_ASSERT_EQUALS(lines[0], "first");
+			for (uint j = 0; j < expected.size(); j++)
+				TS_ASSERT_EQUALS(lines[j + 1], expected[j]);
+		}
+
+		// A different width is a different result
+		Common::Array<Common::String> lines;
+		font.wordWrapText(text, 120, lines);
+		TS_ASSERT_LESS_THAN(lines.size(), expected.size());
+
+		// Changed metrics are picked up after invalidating the cache
+		font._charWidth = 12;
+		uncached._charWidth = 12;
+		font.invalidateLayoutCache();
+		lines.clear();
+		expected.clear();
+		TS_ASSERT_EQUALS(font.wordWrapText(text, 60, lines), uncached.wordWrapText(text, 60, expected));
+		TS_ASSERT_EQUALS(lines.size(), expected.size());
+	}
+
+	void test_wordWrapText_cache_eviction() {
+		const Common::String texts[3] = { "one two three", "four five six", "seven eight nine" };
+		FixedFont font;
+		font.setWordWrapCacheSize(2);
+
+		// Wrap all three texts, keeping the first one recently used, so
+		// that the second one is evicted by the third
+		Common::Array<Common::String> lines;
+		font.wordWrapText(texts[0], 60, lines);
+		font.wordWrapText(texts[1], 60, lines);
+		font.wordWrapText(texts[0], 60, lines);
+		font.wordWrapText(texts[2], 60, lines);
+
+		// Changed metrics only show up for results that are not cached
+		font._charWidth = 12;
+		FixedFont narrow, wide;
+		wide._charWidth = 12;
+
+		Common::Array<Common::String> cached, expected;
+		font.wordWrapText(texts[0], 60, cached);
+		narrow.wordWrapText(texts[0], 60, expected);
+		TS_ASSERT_EQUALS(cached.size(), expected.size());
+
+		cached.clear();
+		expected.clear();
+		font.wordWrapText(texts[2], 60, cached);
+		narrow.wordWrapText(texts[2], 60, expected);
+		TS_ASSERT_EQUALS(cached.size(), expected.size());
+
+		cached.clear();
+		expected.clear();
+		font.wordWrapText(texts[1], 60, cached);
+		wide.wordWrapText(texts[1], 60, expected);
+		TS_ASSERT_EQUALS(cached.size(), expected.size());
+	}
+};
@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transform_cache.h"
+
+class TransformCacheTestSuite : public CxxTest::TestSuite
+{
+	Graphics::Surface _source;
+
+	void makeSource(int w, int h) {
+		_source.create(w, h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		for (int y = 0; y < h; y++)
+			for (int x = 0; x < w; x++)
+				*(uint32 *)_source.getBasePtr(x, y) = (x << 24) | (y << 16) | 0xFF;
+	}
+
+public:
+	void tearDown() {
+		_source.free();
+	}
+
+	void test_scale_matches_uncached() {
+		makeSource(16, 16);
+		Common::Rect srcRect(2, 3, 10, 9);
+		Graphics::TransformCache cache(1024 * 1024);
+
+		Graphics::TransformCache::SurfacePtr cached = cache.scale(this, _source, srcRect, 16, 12, Graphics::FILTER_NEAREST);
+
+		Graphics::TransparentSurface area;
+		area.copyFrom(_source.getSubArea(srcRect));
+		Graphics::TransparentSurface *expected = area.scaleT<Graphics::FILTER_NEAREST>(16, 12);
+
+		TS_ASSERT_EQUALS(cached->w, expected->w);
+		TS_ASSERT_EQUALS(cached->h, expected->h);
+		for (int y = 0; y < expected->h; y++)
+			TS_ASSERT_SAME_DATA(cached->getBasePtr(0, y), expected->getBasePtr(0, y), expected->w * 4);
+
+		expected->free();
+		delete expected;
+		area.free();
+	}
+
+	void test_results_are_reused() {
+		makeSource(16, 16);
+		Common::Rect srcRect(0, 0, 16, 16);
+		Graphics::TransformStruct transform(100, 100, 45);
+		Graphics::TransformCache cache(1024 * 1024);
+
+		Graphics::TransformCache::SurfacePtr first = cache.rotoscale(this, _source, srcRect, transform, Graphics::FILTER_BILINEAR);
+		Graphics::TransformCache::SurfacePtr second = cache.rotoscale(this, _source, srcRect, transform, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_EQUALS(first.get(), second.get());
+
+		// A different filtering mode or angle is a different result
+		Graphics::TransformCache::SurfacePtr nearest = cache.rotoscale(this, _source, srcRect, transform, Graphics::FILTER_NEAREST);
+		TS_ASSERT_DIFFERS(first.get(), nearest.get());
+		transform._angle = 90;
+		Graphics::TransformCache::SurfacePtr rotated = cache.rotoscale(this, _source, srcRect, transform, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_DIFFERS(first.get(), rotated.get());
+	}
+
+	void test_invalidate() {
+		makeSource(16, 16);
+		Common::Rect srcRect(0, 0, 16, 16);
+		Graphics::TransformCache cache(1024 * 1024);
+		int otherOwner;
+
+		Graphics::TransformCache::SurfacePtr first = cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST);
+		cache.scale(&otherOwner, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getSize(), 2U * 8 * 8 * 4);
+
+		cache.invalidate(this);
+		TS_ASSERT_EQUALS(cache.getSize(), 1U * 8 * 8 * 4);
+
+		// The old result stays valid for whoever holds it
+		TS_ASSERT_EQUALS(first->w, 8);
+		Graphics::TransformCache::SurfacePtr second = cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST);
+		TS_ASSERT_DIFFERS(first.get(), second.get());
+	}
+
+	void test_budget() {
+		makeSource(16, 16);
+		Common::Rect srcRect(0, 0, 16, 16);
+		// Room for two 8x8 results
+		Graphics::TransformCache cache(2 * 8 * 8 * 4);
+
+		Graphics::TransformCache::SurfacePtr a = cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST);
+		Graphics::TransformCache::SurfacePtr b = cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_BILINEAR);
+		// Touch a, so that b is the least recently used result
+		TS_ASSERT_EQUALS(cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST).get(), a.get());
+		cache.scale(this, _source, srcRect, 4, 16, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getSize(), 2U * 8 * 8 * 4);
+
+		TS_ASSERT_EQUALS(cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_NEAREST).get(), a.get());
+		TS_ASSERT_DIFFERS(cache.scale(this, _source, srcRect, 8, 8, Graphics::FILTER_BILINEAR).get(), b.get());
+
+		// Results larger than the whole budget are not kept at all
+		cache.scale(this, _source, srcRect, 64, 64, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getSize(), 2U * 8 * 8 * 4);
+	}
+};
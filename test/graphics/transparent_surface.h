@@ -0,0 +1,125 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite
+{
+	Graphics::PixelFormat _format;
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	// Fill with random pixels, with plenty of fully transparent and fully opaque ones
+	void fill(Graphics::Surface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				uint32 a = nextRandom() & 0xFF;
+				if ((a & 3) == 0)
+					a = 0;
+				else if ((a & 3) == 1)
+					a = 255;
+				*(uint32 *)surface.getBasePtr(x, y) = _format.ARGBToColor(a, nextRandom() & 0xFF, nextRandom() & 0xFF, nextRandom() & 0xFF);
+			}
+		}
+	}
+
+	// Subtract in * out * a from out, with the source channel modulated by c unless it is 255
+	static byte subtract(byte in, byte out, byte a, byte c) {
+		if (c != 255)
+			return out - ((uint32)(in * c * out) * a >> 24);
+		return out - (in * out * a >> 16);
+	}
+
+	// The reference per pixel results, as computed by the plain C++ blitting code
+	uint32 blendPixel(uint32 src, uint32 dst, Graphics::TSpriteBlendMode mode, bool binary, uint32 color) {
+		byte sa, sr, sg, sb, da, dr, dg, db;
+		_format.colorToARGB(src, sa, sr, sg, sb);
+		_format.colorToARGB(dst, da, dr, dg, db);
+		const byte cr = (color >> 16) & 0xFF;
+		const byte cg = (color >> 8) & 0xFF;
+		const byte cb = color & 0xFF;
+
+		// With color modulation, subtractive blending makes every pixel opaque
+		if (mode == Graphics::BLEND_SUBTRACTIVE && color != 0xFFFFFFFF)
+			return _format.ARGBToColor(255, subtract(sr, dr, sa, cr), subtract(sg, dg, sa, cg), subtract(sb, db, sa, cb));
+
+		if (sa == 0)
+			return dst;
+
+		if (binary)
+			return _format.ARGBToColor(255, sr, sg, sb);
+
+		switch (mode) {
+		case Graphics::BLEND_ADDITIVE:
+			return _format.ARGBToColor(da, MIN((sr * sa >> 8) + dr, 255), MIN((sg * sa >> 8) + dg, 255), MIN((sb * sa >> 8) + db, 255));
+		case Graphics::BLEND_SUBTRACTIVE:
+			return _format.ARGBToColor(da, subtract(sr, dr, sa, 255), subtract(sg, dg, sa, 255), subtract(sb, db, sa, 255));
+		case Graphics::BLEND_MULTIPLY:
+			return _format.ARGBToColor(da, (sr * sa >> 8) * dr >> 8, (sg * sa >> 8) * dg >> 8, (sb * sa >> 8) * db >> 8);
+		default:
+			return _format.ARGBToColor(255, (sr * sa + dr * (255 - sa)) >> 8, (sg * sa + dg * (255 - sa)) >> 8, (sb * sa + db * (255 - sa)) >> 8);
+		}
+	}
+
+	void checkBlit(Graphics::TSpriteBlendMode mode, bool binary, uint32 color = TS_ARGB(255, 255, 255, 255)) {
+		// Odd sizes, so that both the vectorized and the remaining pixels are tested
+		Graphics::TransparentSurface src, dst, orig;
+		src.create(37, 9, _format);
+		dst.create(45, 11, _format);
+		fill(src);
+		fill(dst);
+		orig.copyFrom(dst);
+
+		if (binary)
+			src.setAlphaMode(Graphics::ALPHA_BINARY);
+
+		src.blit(dst, 3, 1, Graphics::FLIP_NONE, nullptr, color, -1, -1, mode);
+
+		for (int y = 0; y < dst.h; y++) {
+			for (int x = 0; x < dst.w; x++) {
+				uint32 expected = *(uint32 *)orig.getBasePtr(x, y);
+				if (x >= 3 && x < 3 + src.w && y >= 1 && y < 1 + src.h)
+					expected = blendPixel(*(uint32 *)src.getBasePtr(x - 3, y - 1), expected, mode, binary, color);
+				TS_ASSERT_EQUALS(*(uint32 *)dst.getBasePtr(x, y), expected);
+			}
+		}
+
+		src.free();
+		dst.free();
+		orig.free();
+	}
+
+	public:
+	void setUp() {
+		_format = Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		_seed = 1;
+	}
+
+	void test_blit_alpha_blend() {
+		checkBlit(Graphics::BLEND_NORMAL, false);
+	}
+
+	void test_blit_binary() {
+		checkBlit(Graphics::BLEND_NORMAL, true);
+	}
+
+	void test_blit_additive_blend() {
+		checkBlit(Graphics::BLEND_ADDITIVE, false);
+	}
+
+	void test_blit_subtractive_blend() {
+		checkBlit(Graphics::BLEND_SUBTRACTIVE, false);
+	}
+
+	void test_blit_subtractive_blend_colormod() {
+		checkBlit(Graphics::BLEND_SUBTRACTIVE, false, TS_ARGB(128, 200, 255, 77));
+	}
+
+	void test_blit_multiply_blend() {
+		checkBlit(Graphics::BLEND_MULTIPLY, false);
+	}
+};
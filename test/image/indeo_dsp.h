@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/codecs/indeo/indeo.h"
+#include "image/codecs/indeo/mem.h"
+
+// Build the plain C++ versions of the DSP functions as IndeoDSPScalar, to
+// check the SSE2 versions used by IndeoDSP against
+#define INDEO_DSP_NO_SSE2
+#define IndeoDSP IndeoDSPScalar
+#include "image/codecs/indeo/indeo_dsp.cpp"
+#undef IndeoDSP
+#undef INDEO_DSP_NO_SSE2
+#undef IMAGE_CODECS_INDEO_INDEO_DSP_H
+#include "image/codecs/indeo/indeo_dsp.h"
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite
+{
+	typedef void (*TransformProc)(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	typedef void (*McProc)(int16 *buf, const int16 *refBuf, uint32 pitch, int mcType);
+	typedef void (*McAvgProc)(int16 *buf, const int16 *refBuf, const int16 *refBuf2, uint32 pitch, int mcType, int mcType2);
+
+	enum {
+		kPitch = 11,	// odd, so that the rows are not aligned
+		kBufSize = 10 * kPitch
+	};
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	// Coefficients as small as usual, or large enough for the results to
+	// be truncated to 16 bits, with some blocks mostly empty
+	void fillCoefficients(int32 *in, uint8 *flags, int block) {
+		const int32 range = (block & 1) ? (1 << 20) : (1 << 10);
+		const bool sparse = (block & 2) != 0;
+		for (int i = 0; i < 64; i++) {
+			if (sparse && (nextRandom() & 7) != 0)
+				in[i] = 0;
+			else
+				in[i] = (int32)(nextRandom() % (2 * range)) - range;
+		}
+		for (int i = 0; i < 8; i++)
+			flags[i] = (block & 4) ? 1 : (nextRandom() & 1);
+	}
+
+	void fillPixels(int16 *buf, uint size) {
+		for (uint i = 0; i < size; i++)
+			buf[i] = (int16)(nextRandom() & 0xFFFF);
+	}
+
+	void checkTransform(TransformProc sse2, TransformProc scalar) {
+		for (int block = 0; block < 256; block++) {
+			int32 in[64];
+			uint8 flags[8];
+			fillCoefficients(in, flags, block);
+
+			int16 out[kBufSize], expected[kBufSize];
+			fillPixels(out, kBufSize);
+			memcpy(expected, out, sizeof(out));
+
+			sse2(in, out, kPitch, flags);
+			scalar(in, expected, kPitch, flags);
+			TS_ASSERT_EQUALS(memcmp(out, expected, sizeof(out)), 0);
+		}
+	}
+
+	void checkMc(McProc sse2, McProc scalar) {
+		for (int block = 0; block < 64; block++) {
+			int16 ref[kBufSize];
+			fillPixels(ref, kBufSize);
+
+			int16 out[kBufSize], expected[kBufSize];
+			fillPixels(out, kBufSize);
+			memcpy(expected, out, sizeof(out));
+
+			const int mcType = block & 3;
+			sse2(out, ref, kPitch, mcType);
+			scalar(expected, ref, kPitch, mcType);
+			TS_ASSERT_EQUALS(memcmp(out, expected, sizeof(out)), 0);
+		}
+	}
+
+	void checkMcAvg(McAvgProc sse2, McAvgProc scalar) {
+		for (int block = 0; block < 64; block++) {
+			int16 ref[kBufSize], ref2[kBufSize];
+			fillPixels(ref, kBufSize);
+			fillPixels(ref2, kBufSize);
+
+			int16 out[kBufSize], expected[kBufSize];
+			fillPixels(out, kBufSize);
+			memcpy(expected, out, sizeof(out));
+
+			const int mcType = block & 3, mcType2 = (block >> 2) & 3;
+			sse2(out, ref, ref2, kPitch, mcType, mcType2);
+			scalar(expected, ref, ref2, kPitch, mcType, mcType2);
+			TS_ASSERT_EQUALS(memcmp(out, expected, sizeof(out)), 0);
+		}
+	}
+
+public:
+	void setUp() {
+		_seed = 1;
+	}
+
+	void test_inverse_haar_8x8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviInverseHaar8x8, Image::Indeo::IndeoDSPScalar::ffIviInverseHaar8x8);
+	}
+
+	void test_row_haar_8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviRowHaar8, Image::Indeo::IndeoDSPScalar::ffIviRowHaar8);
+	}
+
+	void test_col_haar_8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviColHaar8, Image::Indeo::IndeoDSPScalar::ffIviColHaar8);
+	}
+
+	void test_inverse_slant_8x8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviInverseSlant8x8, Image::Indeo::IndeoDSPScalar::ffIviInverseSlant8x8);
+	}
+
+	void test_row_slant_8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviRowSlant8, Image::Indeo::IndeoDSPScalar::ffIviRowSlant8);
+	}
+
+	void test_col_slant_8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviColSlant8, Image::Indeo::IndeoDSPScalar::ffIviColSlant8);
+	}
+
+	void test_put_pixels_8x8() {
+		checkTransform(Image::Indeo::IndeoDSP::ffIviPutPixels8x8, Image::Indeo::IndeoDSPScalar::ffIviPutPixels8x8);
+	}
+
+	void test_mc_8x8() {
+		checkMc(Image::Indeo::IndeoDSP::ffIviMc8x8NoDelta, Image::Indeo::IndeoDSPScalar::ffIviMc8x8NoDelta);
+		checkMc(Image::Indeo::IndeoDSP::ffIviMc8x8Delta, Image::Indeo::IndeoDSPScalar::ffIviMc8x8Delta);
+	}
+
+	void test_mc_avg_8x8() {
+		checkMcAvg(Image::Indeo::IndeoDSP::ffIviMcAvg8x8NoDelta, Image::Indeo::IndeoDSPScalar::ffIviMcAvg8x8NoDelta);
+		checkMcAvg(Image::Indeo::IndeoDSP::ffIviMcAvg8x8Delta, Image::Indeo::IndeoDSPScalar::ffIviMcAvg8x8Delta);
+	}
+};
@@ -201,7 +201,7 @@ protected:
 
 	class AVIVideoTrack : public FixedRateVideoTrack {
 	public:
-		AVIVideoTrack(int frameCount, const AVIStreamHeader &streamHeader, const BitmapInfoHeader &bitmapInfoHeader, byte *initialPalette = 0);
+		AVIVideoTrack(int frameCount, const AVIStreamHeader &streamHeader, const BitmapInfoHeader &bitmapInfoHeader, const Graphics::PixelFormat &outputFormat, byte *initialPalette = 0);
 		~AVIVideoTrack();
 
 		void decodeFrame(Common::SeekableReadStream *stream);
@@ -271,6 +271,7 @@ protected:
 		int _frameCount, _curFrame;
 		bool _reversed;
 
+		Graphics::PixelFormat _outputFormat;
 		Image::Codec *_videoCodec;
 		const Graphics::Surface *_lastFrame;
 		Image::Codec *createCodec();
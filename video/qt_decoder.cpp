@@ -214,7 +214,7 @@ void QuickTimeDecoder::init() {
 	for (uint32 i = 0; i < tracks.size(); i++) {
 		if (tracks[i]->codecType == CODEC_TYPE_VIDEO) {
 			for (uint32 j = 0; j < tracks[i]->sampleDescs.size(); j++)
-				((VideoSampleDesc *)tracks[i]->sampleDescs[j])->initCodec();
+				((VideoSampleDesc *)tracks[i]->sampleDescs[j])->initCodec(getDefaultHighColorFormat());
 
 			addTrack(new VideoTrackHandler(this, tracks[i]));
 		}
@@ -263,8 +263,13 @@ QuickTimeDecoder::VideoSampleDesc::~VideoSampleDesc() {
 	delete _videoCodec;
 }
 
-void QuickTimeDecoder::VideoSampleDesc::initCodec() {
+void QuickTimeDecoder::VideoSampleDesc::initCodec(const Graphics::PixelFormat &outputFormat) {
 	_videoCodec = Image::createQuickTimeCodec(_codecTag, _parentTrack->width, _parentTrack->height, _bitsPerSample & 0x1f);
+
+	// Codecs converting from YUV can decode straight into the default
+	// high color format; the others keep their native format
+	if (_videoCodec)
+		_videoCodec->setOutputPixelFormat(outputFormat);
 }
 
 QuickTimeDecoder::AudioTrackHandler::AudioTrackHandler(QuickTimeDecoder *decoder, QuickTimeAudioTrack *audioTrack) :
@@ -90,7 +90,7 @@ private:
 		VideoSampleDesc(Common::QuickTimeParser::Track *parentTrack, uint32 codecTag);
 		~VideoSampleDesc();
 
-		void initCodec();
+		void initCodec(const Graphics::PixelFormat &outputFormat);
 
 		// TODO: Make private in the long run
 		uint16 _bitsPerSample;